@@ -49,9 +49,19 @@ CException::CException(const std::ostringstream& f_errorMsg_ss) {
     m_errorMsg_s = f_errorMsg_ss.str();
 }
 
+CException::CException(const std::string& f_errorMsg_s, const std::string& f_details_s) {
+    std::set_terminate(myTerminate);
+    m_errorMsg_s = f_errorMsg_s;
+    m_details_s = f_details_s;
+}
+
 CException::~CException() throw () {
 }
 
 const char* CException::what() const throw () {
     return m_errorMsg_s.c_str();
 }
+
+const std::string& CException::getDetails_s() const throw () {
+    return m_details_s;
+}
@@ -54,8 +54,10 @@ public:
   CException(const std::string& f_errorMsg_s);
   CException(const std::stringstream& f_errorMsg_ss);
   CException(const std::ostringstream& f_errorMsg_ss);
+  CException(const std::string& f_errorMsg_s, const std::string& f_details_s);
   virtual ~CException() throw ();
   const char* what() const throw ();
+  const std::string& getDetails_s() const throw ();
   
   static void myTerminate() {
     std::cout << "unhandled CException" << std::endl;
@@ -63,6 +65,7 @@ public:
   };
 private:
   std::string m_errorMsg_s;
+  std::string m_details_s; // additional information, e.g. output of external program
   
 };
 
@@ -0,0 +1,128 @@
+/**
+ * @file CFile.cpp
+ * @brief CFile class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Helper for files of intermediate results: private temporary directories
+ *   and moving of result files into place without exposing partly written files.
+ *
+ */
+
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "CFile.hpp"
+#include "CException.hpp"
+
+
+// ========================================================================
+// create private directory. Default base is RAM-backed (/dev/shm), i.e.
+// intermediate files do not hit the disk or network file system.
+// ========================================================================
+std::string CFile::createTempDir_s(const std::string& f_baseDir_s)
+{
+  std::string l_base_s = f_baseDir_s;
+  if (l_base_s.empty()) {
+    const char* l_tmpDir_pc = std::getenv("TMPDIR");
+    if (0 == access("/dev/shm", W_OK)) {
+      l_base_s = "/dev/shm";
+    } else if ((NULL != l_tmpDir_pc) && ('\0' != *l_tmpDir_pc)) {
+      l_base_s = l_tmpDir_pc;
+    } else {
+      l_base_s = "/tmp";
+    }
+  }
+  std::string l_template_s = l_base_s + "/ctikz_XXXXXX";
+  std::vector<char> l_template_v(l_template_s.begin(), l_template_s.end());
+  l_template_v.push_back('\0');
+  if (NULL == mkdtemp(&l_template_v[0])) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CFile::createTempDir(): cannot create directory in \"" << l_base_s << "\": " << std::strerror(errno);
+    throw CException(l_msg_ss.str());
+  }
+  return std::string(&l_template_v[0]) + "/";
+}
+
+
+// ========================================================================
+// remove directory with all files in it (no subdirectories)
+// ========================================================================
+void CFile::removeDir_vd(const std::string& f_dir_s)
+{
+  DIR* l_dir_p = opendir(f_dir_s.c_str());
+  if (NULL != l_dir_p) {
+    for (struct dirent* l_entry_p = readdir(l_dir_p); NULL != l_entry_p; l_entry_p = readdir(l_dir_p)) {
+      const std::string l_name_s = l_entry_p->d_name;
+      if (("." != l_name_s) && (".." != l_name_s)) {
+        unlink((f_dir_s + "/" + l_name_s).c_str());
+      }
+    }
+    closedir(l_dir_p);
+  }
+  rmdir(f_dir_s.c_str());
+}
+
+
+// ========================================================================
+// move file. When rename is not possible (different file systems) file is
+// copied into temporary file next to target which is renamed afterwards,
+// i.e. target is never seen partly written. Temporary file gets mode of
+// source file (mkstemp creates it with 0600, source was created under
+// umask of process).
+// ========================================================================
+void CFile::moveFile_vd(const std::string& f_from_s, const std::string& f_to_s)
+{
+  if (0 == std::rename(f_from_s.c_str(), f_to_s.c_str())) {
+    return;
+  }
+  if (EXDEV != errno) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CFile::moveFile(): cannot move \"" << f_from_s << "\" to \"" << f_to_s << "\": " << std::strerror(errno);
+    throw CException(l_msg_ss.str());
+  }
+  std::string l_template_s = f_to_s + ".XXXXXX";
+  std::vector<char> l_template_v(l_template_s.begin(), l_template_s.end());
+  l_template_v.push_back('\0');
+  const int l_fd_i = mkstemp(&l_template_v[0]);
+  if (l_fd_i < 0) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CFile::moveFile(): cannot create temporary file for \"" << f_to_s << "\": " << std::strerror(errno);
+    throw CException(l_msg_ss.str());
+  }
+  struct stat l_stat_st;
+  const bool l_mode_b = (0 == stat(f_from_s.c_str(), &l_stat_st)) && (0 == fchmod(l_fd_i, l_stat_st.st_mode & 0777));
+  close(l_fd_i);
+  const std::string l_temp_s(&l_template_v[0]);
+  std::ifstream l_in_c(f_from_s.c_str(), std::ios::in | std::ios::binary);
+  std::ofstream l_out_c(l_temp_s.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (l_in_c && l_out_c) {
+    l_out_c << l_in_c.rdbuf();
+  }
+  l_out_c.close();
+  if (!l_mode_b || !l_in_c || !l_out_c || (0 != std::rename(l_temp_s.c_str(), f_to_s.c_str()))) {
+    std::remove(l_temp_s.c_str());
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CFile::moveFile(): cannot copy \"" << f_from_s << "\" to \"" << f_to_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  std::remove(f_from_s.c_str());
+}
+
+
+// ========================================================================
+// check if file exists
+// ========================================================================
+bool CFile::exists_b(const std::string& f_filename_s)
+{
+  struct stat l_stat_st;
+  return (0 == stat(f_filename_s.c_str(), &l_stat_st));
+}
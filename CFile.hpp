@@ -0,0 +1,43 @@
+/**
+ * @file CFile.hpp
+ * @brief CFile class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Helper for files of intermediate results: private temporary directories
+ *   and moving of result files into place without exposing partly written files.
+ *
+ * usage:\n
+ * \code
+ * std::string l_dir_s = CFile::createTempDir_s("/dev/shm");
+ * // ... write files into l_dir_s
+ * CFile::moveFile_vd(l_dir_s + "result.pdf", "result.pdf");
+ * CFile::removeDir_vd(l_dir_s);
+ * \endcode
+ *
+ */
+
+#ifndef CFILE_HPP
+#define	CFILE_HPP
+
+#include <string>
+
+class CFile {
+public:
+  
+  // create private directory in given directory (empty: /dev/shm when writable, otherwise
+  // TMPDIR or /tmp). Returned path ends with "/". Throws CException on error.
+  static std::string createTempDir_s(const std::string& f_baseDir_s);
+  
+  // remove directory with all files in it (no subdirectories)
+  static void removeDir_vd(const std::string& f_dir_s);
+  
+  // move file, replacing target atomically (also across file systems). Throws CException on error.
+  static void moveFile_vd(const std::string& f_from_s, const std::string& f_to_s);
+  
+  // check if file exists
+  static bool exists_b(const std::string& f_filename_s);
+};
+
+#endif	/* CFILE_HPP */
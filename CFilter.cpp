@@ -0,0 +1,270 @@
+/**
+ * @file CFilter.cpp
+ * @brief CFilter class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Smoothing filters of equidistant samples, see CFilter.hpp.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "CFilter.hpp"
+#include "CException.hpp"
+
+
+// ========================================================================
+// filter of given data, stages are added afterwards
+// ========================================================================
+CFilter::CFilter(const std::vector<double>& f_data_v) :
+  m_data_pv(&f_data_v),
+  m_next_i(0),
+  m_stage_v()
+{
+}
+
+
+// ========================================================================
+// append centered moving average: ring buffer of window, sum and number
+// of finite values are updated by sample entering and sample leaving
+// ========================================================================
+void CFilter::addMovingAverage_vd(std::size_t f_window_i)
+{
+  if (0 == f_window_i % 2) {
+    throw CException("CFilter::addMovingAverage(): window must have odd number of samples.");
+  }
+  gType_FILTER_Stage_st l_stage_st;
+  l_stage_st.type_e = e_FILTER_TypeMovingAverage;
+  l_stage_st.window_i = f_window_i;
+  l_stage_st.alpha_d = 0;
+  l_stage_st.ring_v.assign(f_window_i, 0);
+  m_stage_v.push_back(l_stage_st);
+  reset_vd();
+}
+
+
+// ========================================================================
+// append exponential smoothing, state is kept in sum of stage
+// ========================================================================
+void CFilter::addExponential_vd(double f_alpha_d)
+{
+  if (!(f_alpha_d > 0) || !(f_alpha_d <= 1)) {
+    throw CException("CFilter::addExponential(): smoothing factor must be within (0, 1].");
+  }
+  gType_FILTER_Stage_st l_stage_st;
+  l_stage_st.type_e = e_FILTER_TypeExponential;
+  l_stage_st.window_i = 1;
+  l_stage_st.alpha_d = f_alpha_d;
+  m_stage_v.push_back(l_stage_st);
+  reset_vd();
+}
+
+
+// ========================================================================
+// append Savitzky-Golay smoothing: weights of all positions within window
+// are computed once. Short data: one window over all samples, order is
+// limited by number of samples.
+// ========================================================================
+void CFilter::addSavitzkyGolay_vd(std::size_t f_window_i,
+                                  unsigned int f_order_i)
+{
+  if (0 == f_window_i % 2) {
+    throw CException("CFilter::addSavitzkyGolay(): window must have odd number of samples.");
+  }
+  if (f_order_i >= f_window_i) {
+    throw CException("CFilter::addSavitzkyGolay(): order of polynomial must be less than window.");
+  }
+  gType_FILTER_Stage_st l_stage_st;
+  l_stage_st.type_e = e_FILTER_TypeSavitzkyGolay;
+  l_stage_st.window_i = std::min(f_window_i, m_data_pv->size());
+  l_stage_st.alpha_d = 0;
+  if (l_stage_st.window_i > 0) {
+    const unsigned int l_order_i = std::min(f_order_i, static_cast<unsigned int>(l_stage_st.window_i - 1));
+    l_stage_st.weights_v.resize(l_stage_st.window_i);
+    for (std::size_t l_t_i = 0; l_t_i < l_stage_st.window_i; ++l_t_i) {
+      l_stage_st.weights_v[l_t_i] = m_getSavitzkyGolayWeights_v(l_stage_st.window_i, l_order_i, l_t_i);
+    }
+  }
+  l_stage_st.ring_v.assign(2 * l_stage_st.window_i, 0);
+  m_stage_v.push_back(l_stage_st);
+  reset_vd();
+}
+
+
+// ========================================================================
+// get filtered value of next sample out of last stage
+// ========================================================================
+double CFilter::next_d()
+{
+  const std::size_t l_done_i = m_stage_v.empty() ? m_next_i : m_stage_v.back().numOutput_i;
+  if (l_done_i >= m_data_pv->size()) {
+    throw CException("CFilter::next(): all samples are read.");
+  }
+  return m_stage_v.empty() ? (*m_data_pv)[m_next_i++] : m_output_d(m_stage_v.size() - 1);
+}
+
+
+// ========================================================================
+// start again at first sample, values within ring buffers are overwritten
+// before they are read
+// ========================================================================
+void CFilter::reset_vd()
+{
+  m_next_i = 0;
+  for (std::vector<gType_FILTER_Stage_st>::iterator l_stage_it = m_stage_v.begin(); l_stage_it != m_stage_v.end(); ++l_stage_it) {
+    l_stage_it->numInput_i = 0;
+    l_stage_it->numOutput_i = 0;
+    l_stage_it->sum_d = 0;
+    l_stage_it->count_i = 0;
+  }
+}
+
+
+// ========================================================================
+// get filtered values of all samples, used by writers which need random
+// access (raster graphics, quantiles, index of windows)
+// ========================================================================
+void CFilter::getFiltered_vd(std::vector<double>& f_filtered_v)
+{
+  reset_vd();
+  f_filtered_v.resize(m_data_pv->size());
+  for (std::vector<double>::iterator l_value_it = f_filtered_v.begin(); l_value_it != f_filtered_v.end(); ++l_value_it) {
+    *l_value_it = next_d();
+  }
+}
+
+
+// ========================================================================
+// get next input value of stage
+// ========================================================================
+double CFilter::m_input_d(std::size_t f_stage_i)
+{
+  return (0 == f_stage_i) ? (*m_data_pv)[m_next_i++] : m_output_d(f_stage_i - 1);
+}
+
+
+// ========================================================================
+// get next output value of stage. Stage reads input only as far as its
+// window reaches, i.e. stages before are read at most half a window ahead.
+// ========================================================================
+double CFilter::m_output_d(std::size_t f_stage_i)
+{
+  gType_FILTER_Stage_st& l_stage_st = m_stage_v[f_stage_i];
+  const std::size_t l_size_i = m_data_pv->size();
+  const std::size_t l_window_i = l_stage_st.window_i;
+  const std::size_t l_half_i = l_window_i / 2;
+  const std::size_t l_k_i = l_stage_st.numOutput_i++;
+  switch (l_stage_st.type_e) {
+    case e_FILTER_TypeMovingAverage: {
+      if (l_k_i > l_half_i) { // sample leaving window, its slot is taken by sample entering
+        const double l_leave_d = l_stage_st.ring_v[(l_k_i - l_half_i - 1) % l_window_i];
+        if (std::isfinite(l_leave_d)) {
+          l_stage_st.sum_d -= l_leave_d;
+          --l_stage_st.count_i;
+          if (0 == l_stage_st.count_i) { // no rounding error is carried over gaps
+            l_stage_st.sum_d = 0;
+          }
+        }
+      }
+      while ((l_stage_st.numInput_i < l_size_i) && (l_stage_st.numInput_i <= l_k_i + l_half_i)) {
+        const double l_enter_d = m_input_d(f_stage_i);
+        l_stage_st.ring_v[l_stage_st.numInput_i % l_window_i] = l_enter_d;
+        if (std::isfinite(l_enter_d)) {
+          l_stage_st.sum_d += l_enter_d;
+          ++l_stage_st.count_i;
+        }
+        ++l_stage_st.numInput_i;
+      }
+      const double l_center_d = l_stage_st.ring_v[l_k_i % l_window_i];
+      return std::isfinite(l_center_d) ? l_stage_st.sum_d / l_stage_st.count_i : std::numeric_limits<double>::quiet_NaN();
+    }
+    case e_FILTER_TypeExponential: {
+      const double l_value_d = m_input_d(f_stage_i);
+      if (!std::isfinite(l_value_d)) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      l_stage_st.sum_d = (0 == l_stage_st.count_i) ? l_value_d : (1 - l_stage_st.alpha_d) * l_stage_st.sum_d + l_stage_st.alpha_d * l_value_d;
+      l_stage_st.count_i = 1;
+      return l_stage_st.sum_d;
+    }
+    case e_FILTER_TypeSavitzkyGolay: {
+      // each value is written twice into ring, i.e. window starts at any slot and is contiguous
+      const std::size_t l_start_i = std::min((l_k_i > l_half_i) ? l_k_i - l_half_i : 0, l_size_i - l_window_i);
+      while (l_stage_st.numInput_i < l_start_i + l_window_i) {
+        const double l_enter_d = m_input_d(f_stage_i);
+        l_stage_st.ring_v[l_stage_st.numInput_i % l_window_i] = l_enter_d;
+        l_stage_st.ring_v[l_stage_st.numInput_i % l_window_i + l_window_i] = l_enter_d;
+        ++l_stage_st.numInput_i;
+      }
+      const double* l_window_pd = &l_stage_st.ring_v[l_start_i % l_window_i];
+      const double* l_weights_pd = &l_stage_st.weights_v[l_k_i - l_start_i][0];
+      double l_sum_d = 0;
+      for (std::size_t l_j_i = 0; l_j_i < l_window_i; ++l_j_i) {
+        l_sum_d += l_weights_pd[l_j_i] * l_window_pd[l_j_i];
+      }
+      return std::isfinite(l_sum_d) ? l_sum_d : std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+
+// ========================================================================
+// get weights of least squares polynomial evaluated at position: value at
+// position is coefficient c0 of polynomial in (j - position) / window,
+// c0 = e0^T (A^T A)^-1 A^T y, i.e. weights are A z with (A^T A) z = e0
+// (Gaussian elimination with partial pivoting)
+// ========================================================================
+std::vector<double> CFilter::m_getSavitzkyGolayWeights_v(std::size_t f_window_i,
+                                                         unsigned int f_order_i,
+                                                         std::size_t f_position_i)
+{
+  const std::size_t l_terms_i = f_order_i + 1;
+  std::vector<std::vector<double> > l_design_v(f_window_i, std::vector<double>(l_terms_i));
+  for (std::size_t l_j_i = 0; l_j_i < f_window_i; ++l_j_i) {
+    const double l_offset_d = (static_cast<double>(l_j_i) - static_cast<double>(f_position_i)) / f_window_i;
+    double l_power_d = 1;
+    for (std::size_t l_i_i = 0; l_i_i < l_terms_i; ++l_i_i) {
+      l_design_v[l_j_i][l_i_i] = l_power_d;
+      l_power_d *= l_offset_d;
+    }
+  }
+  // normal equations with right hand side e0 as last column
+  std::vector<std::vector<double> > l_system_v(l_terms_i, std::vector<double>(l_terms_i + 1, 0));
+  for (std::size_t l_r_i = 0; l_r_i < l_terms_i; ++l_r_i) {
+    for (std::size_t l_c_i = 0; l_c_i < l_terms_i; ++l_c_i) {
+      for (std::size_t l_j_i = 0; l_j_i < f_window_i; ++l_j_i) {
+        l_system_v[l_r_i][l_c_i] += l_design_v[l_j_i][l_r_i] * l_design_v[l_j_i][l_c_i];
+      }
+    }
+  }
+  l_system_v[0][l_terms_i] = 1;
+  for (std::size_t l_c_i = 0; l_c_i < l_terms_i; ++l_c_i) {
+    std::size_t l_pivot_i = l_c_i;
+    for (std::size_t l_r_i = l_c_i + 1; l_r_i < l_terms_i; ++l_r_i) {
+      if (std::fabs(l_system_v[l_r_i][l_c_i]) > std::fabs(l_system_v[l_pivot_i][l_c_i])) {
+        l_pivot_i = l_r_i;
+      }
+    }
+    std::swap(l_system_v[l_c_i], l_system_v[l_pivot_i]);
+    for (std::size_t l_r_i = 0; l_r_i < l_terms_i; ++l_r_i) {
+      if (l_r_i == l_c_i) {
+        continue;
+      }
+      const double l_factor_d = l_system_v[l_r_i][l_c_i] / l_system_v[l_c_i][l_c_i];
+      for (std::size_t l_k_i = l_c_i; l_k_i <= l_terms_i; ++l_k_i) {
+        l_system_v[l_r_i][l_k_i] -= l_factor_d * l_system_v[l_c_i][l_k_i];
+      }
+    }
+  }
+  std::vector<double> l_weights_v(f_window_i, 0);
+  for (std::size_t l_j_i = 0; l_j_i < f_window_i; ++l_j_i) {
+    for (std::size_t l_i_i = 0; l_i_i < l_terms_i; ++l_i_i) {
+      l_weights_v[l_j_i] += l_design_v[l_j_i][l_i_i] * l_system_v[l_i_i][l_terms_i] / l_system_v[l_i_i][l_i_i];
+    }
+  }
+  return l_weights_v;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file CFilter.hpp
+ * @brief CFilter class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Smoothing filters of equidistant samples (moving average, exponential
+ *   smoothing, Savitzky-Golay) as stream: values are read in order of samples while data
+ *   is written, e.g. row by row of a table or bucket by bucket of a decimation. Stages
+ *   are chained, each stage keeps only its sliding window (ring buffer) and reads its
+ *   input from stage before, i.e. no filtered copy of data is made. Values which are not
+ *   finite are gaps, they stay gaps in output.
+ *
+ * usage:\n
+ * \code
+ * CFilter l_filter_c(l_dataY_v);
+ * l_filter_c.addMovingAverage_vd(11);
+ * for (std::size_t l_k_i = 0; l_k_i < l_dataY_v.size(); ++l_k_i) {
+ *   const double l_y_d = l_filter_c.next_d();
+ * }
+ * \endcode
+ *
+ */
+
+#ifndef CFILTER_HPP
+#define	CFILTER_HPP
+
+#include <cstddef>
+#include <vector>
+
+// type of filter stage
+typedef enum C_FILTER_Type_e
+{
+  e_FILTER_TypeMovingAverage,
+  e_FILTER_TypeExponential,
+  e_FILTER_TypeSavitzkyGolay
+} gType_FILTER_Type_e;
+
+// filter stage with its sliding window over values of stage before
+typedef struct C_FILTER_Stage_st
+{
+  gType_FILTER_Type_e type_e;
+  std::size_t window_i; // number of samples of window (shortened to size of data)
+  double alpha_d; // smoothing factor of exponential smoothing
+  std::vector<std::vector<double> > weights_v; // Savitzky-Golay weights for each position within window
+  std::vector<double> ring_v; // input values of window, each value is kept twice (window is contiguous)
+  std::size_t numInput_i; // number of input values read
+  std::size_t numOutput_i; // number of output values written
+  double sum_d; // sum of finite values of window (moving average) or state (exponential smoothing)
+  std::size_t count_i; // number of finite values of window (moving average) or of input (exponential smoothing)
+} gType_FILTER_Stage_st;
+
+class CFilter {
+public:
+  
+  // filter of given data (data is referenced, it must live as long as filter). Without
+  // any stage values of data are passed through, adding a stage starts again at first
+  // sample.
+  explicit CFilter(const std::vector<double>& f_data_v);
+  
+  // append centered moving average over window of given (odd) number of samples, window
+  // is shortened at both ends. Gaps within window are left out.
+  void addMovingAverage_vd(std::size_t f_window_i);
+  
+  // append exponential smoothing with smoothing factor alpha (0 < alpha <= 1), starts at
+  // first finite value. Gaps do not change state.
+  void addExponential_vd(double f_alpha_d);
+  
+  // append Savitzky-Golay smoothing: polynomial of given order fitted (least squares) to
+  // window of given (odd) number of samples, evaluated at center sample. At both ends
+  // polynomial of first or last window is evaluated. Samples whose window contains a gap
+  // are gaps.
+  void addSavitzkyGolay_vd(std::size_t f_window_i,
+                           unsigned int f_order_i);
+  
+  // get filtered value of next sample (samples in order of data, starting at first sample)
+  double next_d();
+  
+  // start again at first sample
+  void reset_vd();
+  
+  // get filtered values of all samples
+  void getFiltered_vd(std::vector<double>& f_filtered_v);
+  
+private:
+  
+  // get next input value of stage (value of data or output of stage before)
+  double m_input_d(std::size_t f_stage_i);
+  
+  // get next output value of stage
+  double m_output_d(std::size_t f_stage_i);
+  
+  // get weights of window [0, window) for value of least squares polynomial of given order
+  // at given position of window
+  static std::vector<double> m_getSavitzkyGolayWeights_v(std::size_t f_window_i,
+                                                          unsigned int f_order_i,
+                                                          std::size_t f_position_i);
+  
+  const std::vector<double>* m_data_pv; // data of user
+  std::size_t m_next_i; // index of next value of data
+  std::vector<gType_FILTER_Stage_st> m_stage_v; // stages in order of filtering
+};
+
+#endif	/* CFILTER_HPP */
@@ -0,0 +1,103 @@
+/**
+ * @file CParallel.cpp
+ * @brief CParallel class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Helper to split loops over large data into chunks which are processed
+ *   by several threads. Exceptions thrown by a chunk are rethrown in the calling thread.
+ *
+ */
+
+#include <thread>
+#include <vector>
+#include <exception>
+#include "CParallel.hpp"
+
+// loops of this thread are processed serially
+static thread_local bool g_serial_b = false;
+
+
+// ========================================================================
+// number of threads used for parallel loops
+// ========================================================================
+unsigned int CParallel::numThreads_i()
+{
+  unsigned int l_numThreads_i = std::thread::hardware_concurrency();
+  return (0 == l_numThreads_i) ? 1 : l_numThreads_i;
+}
+
+
+// ========================================================================
+// process loops of calling thread serially
+// ========================================================================
+void CParallel::setSerial_vd(bool f_serial_b)
+{
+  g_serial_b = f_serial_b;
+}
+
+
+// ========================================================================
+// number of chunks for loop of given size
+// ========================================================================
+unsigned int CParallel::numChunks_i(std::size_t f_size_i)
+{
+  if (g_serial_b) {
+    return 1;
+  }
+  std::size_t l_numChunks_i = f_size_i / m_minChunkSize_i;
+  if (l_numChunks_i > numThreads_i()) {
+    l_numChunks_i = numThreads_i();
+  }
+  return (0 == l_numChunks_i) ? 1 : static_cast<unsigned int>(l_numChunks_i);
+}
+
+
+// ========================================================================
+// process indices [0, size) in chunks. First chunk is processed by calling
+// thread, all others by additional threads.
+// ========================================================================
+void CParallel::for_vd(std::size_t f_size_i, const gType_PARALLEL_Body_c& f_body_c)
+{
+  const unsigned int l_numChunks_i = numChunks_i(f_size_i);
+  if (1 == l_numChunks_i) {
+    f_body_c(0, f_size_i, 0);
+    return;
+  }
+  
+  std::vector<std::exception_ptr> l_exception_v(l_numChunks_i);
+  std::vector<std::thread> l_thread_v;
+  l_thread_v.reserve(l_numChunks_i - 1);
+  try {
+    for (unsigned int l_chunk_i = 1; l_chunk_i < l_numChunks_i; ++l_chunk_i) {
+      const std::size_t l_begin_i = f_size_i * l_chunk_i / l_numChunks_i;
+      const std::size_t l_end_i = f_size_i * (l_chunk_i + 1) / l_numChunks_i;
+      l_thread_v.push_back(std::thread([&f_body_c, &l_exception_v, l_begin_i, l_end_i, l_chunk_i]() {
+        try {
+          f_body_c(l_begin_i, l_end_i, l_chunk_i);
+        } catch (...) {
+          l_exception_v[l_chunk_i] = std::current_exception();
+        }
+      }));
+    }
+  } catch (...) { // thread cannot be started: threads already running must be joined before they are destroyed
+    for (std::vector<std::thread>::iterator l_thread_it = l_thread_v.begin(); l_thread_it != l_thread_v.end(); ++l_thread_it) {
+      l_thread_it->join();
+    }
+    throw;
+  }
+  try {
+    f_body_c(0, f_size_i / l_numChunks_i, 0);
+  } catch (...) {
+    l_exception_v[0] = std::current_exception();
+  }
+  for (std::vector<std::thread>::iterator l_thread_it = l_thread_v.begin(); l_thread_it != l_thread_v.end(); ++l_thread_it) {
+    l_thread_it->join();
+  }
+  for (std::vector<std::exception_ptr>::iterator l_exception_it = l_exception_v.begin(); l_exception_it != l_exception_v.end(); ++l_exception_it) {
+    if (*l_exception_it) {
+      std::rethrow_exception(*l_exception_it);
+    }
+  }
+}
@@ -0,0 +1,53 @@
+/**
+ * @file CParallel.hpp
+ * @brief CParallel class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Helper to split loops over large data into chunks which are processed
+ *   by several threads. Exceptions thrown by a chunk are rethrown in the calling thread.
+ *
+ * usage:\n
+ * \code
+ * CParallel::for_vd(data.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int f_thread_i) {
+ *   for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+ *     // ...
+ *   }
+ * });
+ * \endcode
+ *
+ */
+
+#ifndef CPARALLEL_HPP
+#define	CPARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+class CParallel {
+public:
+  
+  // loop body which processes indices [begin, end). thread is index of chunk (0 ... numThreads-1)
+  typedef std::function<void(std::size_t f_begin_i, std::size_t f_end_i, unsigned int f_thread_i)> gType_PARALLEL_Body_c;
+  
+  // number of threads used for parallel loops (number of cores, at least 1)
+  static unsigned int numThreads_i();
+  
+  // number of chunks for loop of given size (loops below minimal chunk size are not split)
+  static unsigned int numChunks_i(std::size_t f_size_i);
+  
+  // loops of calling thread are processed serially without additional threads (default: false),
+  // e.g. when calling thread is already one of several worker threads
+  static void setSerial_vd(bool f_serial_b);
+  
+  // process indices [0, size) in chunks, one chunk per thread. Blocks until all chunks are done.
+  static void for_vd(std::size_t f_size_i, const gType_PARALLEL_Body_c& f_body_c);
+  
+private:
+  
+  // minimal number of indices per chunk, smaller loops are processed by calling thread
+  static const std::size_t m_minChunkSize_i = 16384;
+};
+
+#endif	/* CPARALLEL_HPP */
@@ -0,0 +1,277 @@
+/**
+ * @file CPng.cpp
+ * @brief CPng class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Writes RGBA images as PNG files without external libraries. Image data
+ *   is compressed with deflate (fixed Huffman codes, run length matches), which is
+ *   efficient for rasterized plots with large uniform areas.
+ *
+ */
+
+#include <fstream>
+#include <sstream>
+#include "CPng.hpp"
+#include "CException.hpp"
+
+// bit writer for deflate stream (bits are packed starting with least significant bit)
+typedef struct C_PNG_BitWriter_st
+{
+  std::string* buffer_p; // output buffer
+  uint32_t bits_i; // pending bits
+  unsigned int numBits_i; // number of pending bits
+} gType_PNG_BitWriter_st;
+
+static void g_writeBits_vd(gType_PNG_BitWriter_st& f_writer_st, uint32_t f_value_i, unsigned int f_numBits_i);
+static void g_writeHuffman_vd(gType_PNG_BitWriter_st& f_writer_st, uint32_t f_code_i, unsigned int f_numBits_i);
+static void g_writeLiteral_vd(gType_PNG_BitWriter_st& f_writer_st, unsigned int f_symbol_i);
+static void g_writeMatch_vd(gType_PNG_BitWriter_st& f_writer_st, unsigned int f_length_i);
+static void g_flushBits_vd(gType_PNG_BitWriter_st& f_writer_st);
+
+// create table of CRC32 (one entry per byte value)
+static std::vector<uint32_t> g_createCrcTable_v();
+
+
+// ========================================================================
+// write RGBA image into PNG file
+// ========================================================================
+void CPng::write_vd(const std::string& f_filename_s,
+                    unsigned int f_width_i,
+                    unsigned int f_height_i,
+                    const std::vector<unsigned char>& f_rgba_v)
+{
+  const std::size_t l_rowSize_i = static_cast<std::size_t>(f_width_i) * 4;
+  if ((0 == f_width_i) || (0 == f_height_i) || (f_rgba_v.size() != l_rowSize_i * f_height_i)) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CPng::write(): invalid image size " << f_width_i << "x" << f_height_i << ".";
+    throw CException(l_msg_ss.str());
+  }
+  
+  // filter each row with filter type 1 (difference to left pixel), i.e. uniform
+  // areas become runs of zeros
+  std::vector<unsigned char> l_filtered_v;
+  l_filtered_v.reserve((l_rowSize_i + 1) * f_height_i);
+  for (unsigned int l_row_i = 0; l_row_i < f_height_i; ++l_row_i) {
+    const unsigned char* l_row_p = &f_rgba_v[l_row_i * l_rowSize_i];
+    l_filtered_v.push_back(1);
+    for (std::size_t l_k_i = 0; l_k_i < l_rowSize_i; ++l_k_i) {
+      const unsigned char l_left_i = (l_k_i >= 4) ? l_row_p[l_k_i - 4] : 0;
+      l_filtered_v.push_back(static_cast<unsigned char>(l_row_p[l_k_i] - l_left_i));
+    }
+  }
+  
+  std::string l_header_s;
+  m_appendU32_vd(l_header_s, f_width_i);
+  m_appendU32_vd(l_header_s, f_height_i);
+  l_header_s += static_cast<char>(8); // bit depth
+  l_header_s += static_cast<char>(6); // color type RGBA
+  l_header_s += static_cast<char>(0); // compression method
+  l_header_s += static_cast<char>(0); // filter method
+  l_header_s += static_cast<char>(0); // no interlace
+  
+  std::string l_png_s("\x89PNG\r\n\x1a\n", 8);
+  m_appendChunk_vd(l_png_s, "IHDR", l_header_s);
+  m_appendChunk_vd(l_png_s, "IDAT", m_deflate_s(l_filtered_v));
+  m_appendChunk_vd(l_png_s, "IEND", "");
+  
+  std::ofstream l_file_c;
+  l_file_c.open(f_filename_s.c_str(), std::ios::out | std::ios::binary);
+  if (l_file_c) {
+    l_file_c.write(l_png_s.data(), l_png_s.size());
+  }
+  if (!l_file_c) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Cannot write into file \"" << f_filename_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  l_file_c.close();
+}
+
+
+// ========================================================================
+// append PNG chunk to buffer
+// ========================================================================
+void CPng::m_appendChunk_vd(std::string& f_png_s,
+                            const char* f_type_pc,
+                            const std::string& f_data_s)
+{
+  m_appendU32_vd(f_png_s, static_cast<uint32_t>(f_data_s.size()));
+  std::string l_chunk_s(f_type_pc, 4);
+  l_chunk_s += f_data_s;
+  f_png_s += l_chunk_s;
+  m_appendU32_vd(f_png_s, m_crc32_i(l_chunk_s.data(), l_chunk_s.size(), 0));
+}
+
+
+// ========================================================================
+// compress data into zlib stream: one deflate block with fixed Huffman
+// codes. Repeated bytes are encoded as matches with distance 1.
+// ========================================================================
+std::string CPng::m_deflate_s(const std::vector<unsigned char>& f_data_v)
+{
+  std::string l_zlib_s;
+  l_zlib_s.reserve(f_data_v.size() / 4 + 64);
+  l_zlib_s += static_cast<char>(0x78); // deflate, 32k window
+  l_zlib_s += static_cast<char>(0x01); // no dictionary, check bits
+  
+  gType_PNG_BitWriter_st l_writer_st;
+  l_writer_st.buffer_p = &l_zlib_s;
+  l_writer_st.bits_i = 0;
+  l_writer_st.numBits_i = 0;
+  g_writeBits_vd(l_writer_st, 1, 1); // final block
+  g_writeBits_vd(l_writer_st, 1, 2); // fixed Huffman codes
+  
+  const std::size_t l_size_i = f_data_v.size();
+  std::size_t l_pos_i = 0;
+  while (l_pos_i < l_size_i) {
+    std::size_t l_run_i = 0;
+    if (l_pos_i > 0) {
+      const unsigned char l_prev_i = f_data_v[l_pos_i - 1];
+      while ((l_run_i < 258) && (l_pos_i + l_run_i < l_size_i) && (f_data_v[l_pos_i + l_run_i] == l_prev_i)) {
+        ++l_run_i;
+      }
+    }
+    if (l_run_i >= 3) {
+      g_writeMatch_vd(l_writer_st, static_cast<unsigned int>(l_run_i));
+      l_pos_i += l_run_i;
+    } else {
+      g_writeLiteral_vd(l_writer_st, f_data_v[l_pos_i]);
+      ++l_pos_i;
+    }
+  }
+  g_writeLiteral_vd(l_writer_st, 256); // end of block
+  g_flushBits_vd(l_writer_st);
+  
+  // Adler-32 checksum of uncompressed data
+  uint32_t l_a_i = 1;
+  uint32_t l_b_i = 0;
+  for (std::size_t l_k_i = 0; l_k_i < l_size_i; ++l_k_i) {
+    l_a_i = (l_a_i + f_data_v[l_k_i]) % 65521;
+    l_b_i = (l_b_i + l_a_i) % 65521;
+  }
+  m_appendU32_vd(l_zlib_s, (l_b_i << 16) | l_a_i);
+  return l_zlib_s;
+}
+
+
+// ========================================================================
+// CRC32 (polynomial 0xedb88320) as used by PNG chunks. Table is created
+// at first call (initialization of local static is thread-safe).
+// ========================================================================
+uint32_t CPng::m_crc32_i(const char* f_data_pc, std::size_t f_size_i, uint32_t f_crc_i)
+{
+  static const std::vector<uint32_t> l_table_v = g_createCrcTable_v();
+  uint32_t l_crc_i = f_crc_i ^ 0xffffffffu;
+  for (std::size_t l_k_i = 0; l_k_i < f_size_i; ++l_k_i) {
+    l_crc_i = l_table_v[(l_crc_i ^ static_cast<unsigned char>(f_data_pc[l_k_i])) & 0xff] ^ (l_crc_i >> 8);
+  }
+  return l_crc_i ^ 0xffffffffu;
+}
+
+
+// ========================================================================
+// append 32 bit big endian value to buffer
+// ========================================================================
+void CPng::m_appendU32_vd(std::string& f_buffer_s, uint32_t f_value_i)
+{
+  f_buffer_s += static_cast<char>((f_value_i >> 24) & 0xff);
+  f_buffer_s += static_cast<char>((f_value_i >> 16) & 0xff);
+  f_buffer_s += static_cast<char>((f_value_i >> 8) & 0xff);
+  f_buffer_s += static_cast<char>(f_value_i & 0xff);
+}
+
+
+// ========================================================================
+// write bits into deflate stream (least significant bit first)
+// ========================================================================
+static void g_writeBits_vd(gType_PNG_BitWriter_st& f_writer_st, uint32_t f_value_i, unsigned int f_numBits_i)
+{
+  f_writer_st.bits_i |= f_value_i << f_writer_st.numBits_i;
+  f_writer_st.numBits_i += f_numBits_i;
+  while (f_writer_st.numBits_i >= 8) {
+    *f_writer_st.buffer_p += static_cast<char>(f_writer_st.bits_i & 0xff);
+    f_writer_st.bits_i >>= 8;
+    f_writer_st.numBits_i -= 8;
+  }
+}
+
+
+// ========================================================================
+// write Huffman code into deflate stream (most significant bit first)
+// ========================================================================
+static void g_writeHuffman_vd(gType_PNG_BitWriter_st& f_writer_st, uint32_t f_code_i, unsigned int f_numBits_i)
+{
+  uint32_t l_reversed_i = 0;
+  for (unsigned int l_k_i = 0; l_k_i < f_numBits_i; ++l_k_i) {
+    l_reversed_i = (l_reversed_i << 1) | ((f_code_i >> l_k_i) & 1);
+  }
+  g_writeBits_vd(f_writer_st, l_reversed_i, f_numBits_i);
+}
+
+
+// ========================================================================
+// write literal/length symbol with fixed Huffman code
+// ========================================================================
+static void g_writeLiteral_vd(gType_PNG_BitWriter_st& f_writer_st, unsigned int f_symbol_i)
+{
+  if (f_symbol_i < 144) {
+    g_writeHuffman_vd(f_writer_st, 0x30 + f_symbol_i, 8);
+  } else if (f_symbol_i < 256) {
+    g_writeHuffman_vd(f_writer_st, 0x190 + f_symbol_i - 144, 9);
+  } else if (f_symbol_i < 280) {
+    g_writeHuffman_vd(f_writer_st, f_symbol_i - 256, 7);
+  } else {
+    g_writeHuffman_vd(f_writer_st, 0xc0 + f_symbol_i - 280, 8);
+  }
+}
+
+
+// ========================================================================
+// write match with given length (3 ... 258) and distance 1
+// ========================================================================
+static void g_writeMatch_vd(gType_PNG_BitWriter_st& f_writer_st, unsigned int f_length_i)
+{
+  static const unsigned int l_base_pi[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                             35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+  static const unsigned int l_extra_pi[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                              3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+  unsigned int l_code_i = 28;
+  while (l_base_pi[l_code_i] > f_length_i) {
+    --l_code_i;
+  }
+  g_writeLiteral_vd(f_writer_st, 257 + l_code_i);
+  g_writeBits_vd(f_writer_st, f_length_i - l_base_pi[l_code_i], l_extra_pi[l_code_i]);
+  g_writeHuffman_vd(f_writer_st, 0, 5); // distance code 0: distance 1
+}
+
+
+// ========================================================================
+// write pending bits of deflate stream (pad to full byte)
+// ========================================================================
+static void g_flushBits_vd(gType_PNG_BitWriter_st& f_writer_st)
+{
+  if (f_writer_st.numBits_i > 0) {
+    *f_writer_st.buffer_p += static_cast<char>(f_writer_st.bits_i & 0xff);
+  }
+  f_writer_st.bits_i = 0;
+  f_writer_st.numBits_i = 0;
+}
+
+
+// ========================================================================
+// create table of CRC32 (polynomial 0xedb88320)
+// ========================================================================
+static std::vector<uint32_t> g_createCrcTable_v()
+{
+  std::vector<uint32_t> l_table_v(256);
+  for (uint32_t l_n_i = 0; l_n_i < 256; ++l_n_i) {
+    uint32_t l_c_i = l_n_i;
+    for (int l_k_i = 0; l_k_i < 8; ++l_k_i) {
+      l_c_i = (l_c_i & 1) ? (0xedb88320u ^ (l_c_i >> 1)) : (l_c_i >> 1);
+    }
+    l_table_v[l_n_i] = l_c_i;
+  }
+  return l_table_v;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file CPng.hpp
+ * @brief CPng class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Writes RGBA images as PNG files without external libraries. Image data
+ *   is compressed with deflate (fixed Huffman codes, run length matches), which is
+ *   efficient for rasterized plots with large uniform areas.
+ *
+ * usage:\n
+ * \code
+ * std::vector<unsigned char> l_rgba_v(width * height * 4, 0);
+ * // ...
+ * CPng::write_vd("image.png", width, height, l_rgba_v);
+ * \endcode
+ *
+ */
+
+#ifndef CPNG_HPP
+#define	CPNG_HPP
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class CPng {
+public:
+  
+  // write RGBA image (4 bytes per pixel, rows from top to bottom) into PNG file
+  static void write_vd(const std::string& f_filename_s,
+                       unsigned int f_width_i,
+                       unsigned int f_height_i,
+                       const std::vector<unsigned char>& f_rgba_v);
+  
+private:
+  
+  // append PNG chunk (length, type, data, CRC) to buffer
+  static void m_appendChunk_vd(std::string& f_png_s,
+                               const char* f_type_pc,
+                               const std::string& f_data_s);
+  
+  // compress data into zlib stream
+  static std::string m_deflate_s(const std::vector<unsigned char>& f_data_v);
+  
+  // CRC32 as used by PNG chunks
+  static uint32_t m_crc32_i(const char* f_data_pc, std::size_t f_size_i, uint32_t f_crc_i);
+  
+  // append 32 bit big endian value to buffer
+  static void m_appendU32_vd(std::string& f_buffer_s, uint32_t f_value_i);
+};
+
+#endif	/* CPNG_HPP */
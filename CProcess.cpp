@@ -0,0 +1,296 @@
+/**
+ * @file CProcess.cpp
+ * @brief CProcess class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Runs external programs without shell (posix_spawn). Output of program
+ *   (stdout and stderr) is captured up to a maximum size, program is killed when it
+ *   does not finish within timeout. Programs can also be started in advance and fed
+ *   via stdin (see spawn_st).
+ *
+ */
+
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <sstream>
+#include "CProcess.hpp"
+#include "CException.hpp"
+
+extern char** environ;
+
+
+// ========================================================================
+// run program and wait until it finishes or timeout expires
+// ========================================================================
+gType_PROCESS_Result_st CProcess::run_st(const std::vector<std::string>& f_args_v,
+                                         double f_timeout_d,
+                                         std::size_t f_maxOutput_i,
+                                         const std::vector<std::string>& f_env_v)
+{
+  const bool l_pipeStdin_b = false;
+  gType_PROCESS_Child_st l_child_st = spawn_st(f_args_v, l_pipeStdin_b, f_env_v);
+  return wait_st(l_child_st, f_timeout_d, f_maxOutput_i);
+}
+
+
+// ========================================================================
+// start program. Program gets its own process group, i.e. child processes
+// are killed together with it. Pipes are not inherited by other programs
+// (close on exec), otherwise end of file would never be seen.
+// ========================================================================
+gType_PROCESS_Child_st CProcess::spawn_st(const std::vector<std::string>& f_args_v,
+                                          bool f_pipeStdin_b,
+                                          const std::vector<std::string>& f_env_v)
+{
+  if (f_args_v.empty()) {
+    throw CException("CProcess::spawn(): no program given.");
+  }
+  int l_output_pi[2];
+  int l_stdin_pi[2] = {-1, -1};
+  if (0 != pipe2(l_output_pi, O_CLOEXEC)) {
+    throw CException("CProcess::spawn(): cannot create pipe.");
+  }
+  if (f_pipeStdin_b && (0 != pipe2(l_stdin_pi, O_CLOEXEC))) {
+    close(l_output_pi[0]);
+    close(l_output_pi[1]);
+    throw CException("CProcess::spawn(): cannot create pipe.");
+  }
+  
+  posix_spawn_file_actions_t l_actions_st;
+  posix_spawn_file_actions_init(&l_actions_st);
+  if (f_pipeStdin_b) {
+    posix_spawn_file_actions_adddup2(&l_actions_st, l_stdin_pi[0], 0);
+  } else {
+    posix_spawn_file_actions_addopen(&l_actions_st, 0, "/dev/null", O_RDONLY, 0);
+  }
+  posix_spawn_file_actions_adddup2(&l_actions_st, l_output_pi[1], 1);
+  posix_spawn_file_actions_adddup2(&l_actions_st, l_output_pi[1], 2);
+  posix_spawnattr_t l_attr_st;
+  posix_spawnattr_init(&l_attr_st);
+  posix_spawnattr_setflags(&l_attr_st, POSIX_SPAWN_SETPGROUP);
+  posix_spawnattr_setpgroup(&l_attr_st, 0);
+  
+  std::vector<char*> l_argv_v;
+  for (std::vector<std::string>::const_iterator l_arg_it = f_args_v.begin(); l_arg_it != f_args_v.end(); ++l_arg_it) {
+    l_argv_v.push_back(const_cast<char*>(l_arg_it->c_str()));
+  }
+  l_argv_v.push_back(NULL);
+  
+  // environment of calling process, given variables replace existing ones
+  std::vector<char*> l_envp_v;
+  for (char** l_env_pp = environ; NULL != *l_env_pp; ++l_env_pp) {
+    const std::string l_entry_s = *l_env_pp;
+    bool l_replaced_b = false;
+    for (std::vector<std::string>::const_iterator l_env_it = f_env_v.begin(); l_env_it != f_env_v.end(); ++l_env_it) {
+      const std::string::size_type l_nameSize_i = l_env_it->find('=');
+      if ((std::string::npos != l_nameSize_i) && (0 == l_entry_s.compare(0, l_nameSize_i + 1, *l_env_it, 0, l_nameSize_i + 1))) {
+        l_replaced_b = true;
+      }
+    }
+    if (!l_replaced_b) {
+      l_envp_v.push_back(*l_env_pp);
+    }
+  }
+  for (std::vector<std::string>::const_iterator l_env_it = f_env_v.begin(); l_env_it != f_env_v.end(); ++l_env_it) {
+    l_envp_v.push_back(const_cast<char*>(l_env_it->c_str()));
+  }
+  l_envp_v.push_back(NULL);
+  
+  gType_PROCESS_Child_st l_child_st;
+  l_child_st.pid_i = 0;
+  const int l_error_i = posix_spawnp(&l_child_st.pid_i, l_argv_v[0], &l_actions_st, &l_attr_st, &l_argv_v[0], &l_envp_v[0]);
+  posix_spawn_file_actions_destroy(&l_actions_st);
+  posix_spawnattr_destroy(&l_attr_st);
+  close(l_output_pi[1]);
+  if (f_pipeStdin_b) {
+    close(l_stdin_pi[0]);
+  }
+  if (0 != l_error_i) {
+    close(l_output_pi[0]);
+    if (f_pipeStdin_b) {
+      close(l_stdin_pi[1]);
+    }
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CProcess::spawn(): cannot start \"" << f_args_v[0] << "\": " << std::strerror(l_error_i);
+    throw CException(l_msg_ss.str());
+  }
+  l_child_st.stdin_i = l_stdin_pi[1];
+  l_child_st.output_i = l_output_pi[0];
+  return l_child_st;
+}
+
+
+// ========================================================================
+// write into stdin of program. SIGPIPE of a program which already exited
+// is blocked for this thread and discarded, write fails with EPIPE instead.
+// ========================================================================
+void CProcess::write_vd(gType_PROCESS_Child_st& f_child_st, const std::string& f_data_s)
+{
+  if (f_child_st.stdin_i < 0) {
+    throw CException("CProcess::write(): stdin of program is closed.");
+  }
+  sigset_t l_pipeSet_st;
+  sigset_t l_oldSet_st;
+  sigemptyset(&l_pipeSet_st);
+  sigaddset(&l_pipeSet_st, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &l_pipeSet_st, &l_oldSet_st);
+  std::size_t l_written_i = 0;
+  int l_error_i = 0;
+  while (l_written_i < f_data_s.size()) {
+    const ssize_t l_size_i = write(f_child_st.stdin_i, f_data_s.data() + l_written_i, f_data_s.size() - l_written_i);
+    if (l_size_i < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      l_error_i = errno;
+      break;
+    }
+    l_written_i += static_cast<std::size_t>(l_size_i);
+  }
+  if (EPIPE == l_error_i) {
+    const struct timespec l_noWait_st = {0, 0};
+    sigtimedwait(&l_pipeSet_st, NULL, &l_noWait_st);
+  }
+  pthread_sigmask(SIG_SETMASK, &l_oldSet_st, NULL);
+  if (0 != l_error_i) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CProcess::write(): cannot write into stdin of program: " << std::strerror(l_error_i);
+    throw CException(l_msg_ss.str());
+  }
+}
+
+
+// ========================================================================
+// close stdin of program
+// ========================================================================
+void CProcess::closeStdin_vd(gType_PROCESS_Child_st& f_child_st)
+{
+  if (f_child_st.stdin_i >= 0) {
+    close(f_child_st.stdin_i);
+    f_child_st.stdin_i = -1;
+  }
+}
+
+
+// ========================================================================
+// capture output of program and wait until it finishes or timeout expires
+// ========================================================================
+gType_PROCESS_Result_st CProcess::wait_st(gType_PROCESS_Child_st& f_child_st,
+                                          double f_timeout_d,
+                                          std::size_t f_maxOutput_i)
+{
+  // capture output until program closes its end of pipe or timeout expires
+  gType_PROCESS_Result_st l_result_st;
+  l_result_st.exitCode_i = -1;
+  l_result_st.timeout_b = false;
+  l_result_st.outputSize_i = 0;
+  const std::chrono::steady_clock::time_point l_deadline_c = std::chrono::steady_clock::now() +
+    std::chrono::milliseconds(static_cast<long long>(f_timeout_d * 1000));
+  char l_buffer_pc[4096];
+  while (true) {
+    int l_wait_i = -1;
+    if (f_timeout_d > 0) {
+      const long long l_remaining_i = std::chrono::duration_cast<std::chrono::milliseconds>(l_deadline_c - std::chrono::steady_clock::now()).count();
+      if (l_remaining_i <= 0) {
+        l_result_st.timeout_b = true;
+        break;
+      }
+      l_wait_i = static_cast<int>(std::min(l_remaining_i, 1000LL));
+    }
+    struct pollfd l_poll_st;
+    l_poll_st.fd = f_child_st.output_i;
+    l_poll_st.events = POLLIN;
+    l_poll_st.revents = 0;
+    const int l_ready_i = poll(&l_poll_st, 1, l_wait_i);
+    if ((l_ready_i < 0) && (EINTR != errno)) {
+      break;
+    }
+    if (l_ready_i <= 0) {
+      continue;
+    }
+    const ssize_t l_read_i = read(f_child_st.output_i, l_buffer_pc, sizeof(l_buffer_pc));
+    if (l_read_i < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      break;
+    }
+    if (0 == l_read_i) { // end of output
+      break;
+    }
+    l_result_st.outputSize_i += static_cast<std::size_t>(l_read_i);
+    l_result_st.output_s.append(l_buffer_pc, static_cast<std::size_t>(l_read_i));
+    if (l_result_st.output_s.size() > 2 * f_maxOutput_i) { // keep end of output, trim in blocks
+      l_result_st.output_s.erase(0, l_result_st.output_s.size() - f_maxOutput_i);
+    }
+  }
+  if (l_result_st.output_s.size() > f_maxOutput_i) {
+    l_result_st.output_s.erase(0, l_result_st.output_s.size() - f_maxOutput_i);
+  }
+  
+  // program may still run after closing its output. When waitpid fails (e.g. ECHILD because
+  // SIGCHLD is ignored) status is unknown, i.e. run is not reported as successful.
+  int l_status_i = 0;
+  bool l_finished_b = false;
+  bool l_waitFailed_b = false;
+  while (!l_finished_b && !l_result_st.timeout_b && (f_timeout_d > 0)) {
+    const pid_t l_done_i = waitpid(f_child_st.pid_i, &l_status_i, WNOHANG);
+    if ((l_done_i < 0) && (EINTR != errno)) {
+      l_finished_b = true;
+      l_waitFailed_b = true;
+    } else if (l_done_i == f_child_st.pid_i) {
+      l_finished_b = true;
+    } else if (std::chrono::steady_clock::now() >= l_deadline_c) {
+      l_result_st.timeout_b = true;
+    } else {
+      usleep(10000);
+    }
+  }
+  if (l_result_st.timeout_b) {
+    kill_vd(f_child_st);
+  } else {
+    while (!l_finished_b) {
+      if (waitpid(f_child_st.pid_i, &l_status_i, 0) >= 0) {
+        l_finished_b = true;
+      } else if (EINTR != errno) {
+        l_finished_b = true;
+        l_waitFailed_b = true;
+      }
+    }
+    closeStdin_vd(f_child_st);
+    close(f_child_st.output_i);
+    f_child_st.output_i = -1;
+    if (!l_waitFailed_b && WIFEXITED(l_status_i)) {
+      l_result_st.exitCode_i = WEXITSTATUS(l_status_i);
+    }
+  }
+  return l_result_st;
+}
+
+
+// ========================================================================
+// kill program and its child processes
+// ========================================================================
+void CProcess::kill_vd(gType_PROCESS_Child_st& f_child_st)
+{
+  kill(-f_child_st.pid_i, SIGKILL);
+  int l_status_i = 0;
+  while ((waitpid(f_child_st.pid_i, &l_status_i, 0) < 0) && (EINTR == errno)) {
+  }
+  closeStdin_vd(f_child_st);
+  if (f_child_st.output_i >= 0) {
+    close(f_child_st.output_i);
+    f_child_st.output_i = -1;
+  }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file CProcess.hpp
+ * @brief CProcess class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Runs external programs without shell (posix_spawn). Output of program
+ *   (stdout and stderr) is captured up to a maximum size, program is killed when it
+ *   does not finish within timeout. Programs can also be started in advance and fed
+ *   via stdin (see spawn_st).
+ *
+ * usage:\n
+ * \code
+ * std::vector<std::string> l_args_v;
+ * l_args_v.push_back("pdflatex");
+ * l_args_v.push_back("file.tex");
+ * gType_PROCESS_Result_st l_result_st = CProcess::run_st(l_args_v, 60.0);
+ * if (l_result_st.timeout_b || (0 != l_result_st.exitCode_i)) {
+ *   std::cout << l_result_st.output_s;
+ * }
+ * \endcode
+ *
+ */
+
+#ifndef CPROCESS_HPP
+#define	CPROCESS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+// result of external program
+typedef struct C_PROCESS_Result_st
+{
+  int exitCode_i; // exit code of program, -1 when program was terminated by signal or status is unknown
+  bool timeout_b; // program was killed because timeout expired
+  std::string output_s; // end of output (stdout and stderr) of program
+  std::size_t outputSize_i; // complete size of output in bytes (captured or not)
+} gType_PROCESS_Result_st;
+
+// running external program
+typedef struct C_PROCESS_Child_st
+{
+  pid_t pid_i; // process ID (also ID of process group of program)
+  int stdin_i; // write end of pipe to stdin of program, -1 when stdin is /dev/null or closed
+  int output_i; // read end of pipe from stdout and stderr of program
+} gType_PROCESS_Child_st;
+
+class CProcess {
+public:
+  
+  // run program (first argument, searched in PATH) with given arguments and wait until it
+  // finishes. stdin is /dev/null. Program and its child processes are killed after timeout
+  // in seconds (0: no timeout). Only last maxOutput bytes of output are kept. Environment
+  // variables ("NAME=value") are added to environment of calling process or replace them.
+  // Throws CException when program cannot be started.
+  static gType_PROCESS_Result_st run_st(const std::vector<std::string>& f_args_v,
+                                        double f_timeout_d,
+                                        std::size_t f_maxOutput_i = 65536,
+                                        const std::vector<std::string>& f_env_v = std::vector<std::string>());
+  
+  // start program without waiting for it. When pipeStdin is set, stdin of program can be
+  // written via write_vd, otherwise stdin is /dev/null. Result has to be fetched by wait_st.
+  static gType_PROCESS_Child_st spawn_st(const std::vector<std::string>& f_args_v,
+                                         bool f_pipeStdin_b,
+                                         const std::vector<std::string>& f_env_v = std::vector<std::string>());
+  
+  // write into stdin of program. Throws CException when program does not read anymore.
+  static void write_vd(gType_PROCESS_Child_st& f_child_st, const std::string& f_data_s);
+  
+  // close stdin of program, i.e. program reads end of file
+  static void closeStdin_vd(gType_PROCESS_Child_st& f_child_st);
+  
+  // capture output of program and wait until it finishes (see run_st for timeout and output)
+  static gType_PROCESS_Result_st wait_st(gType_PROCESS_Child_st& f_child_st,
+                                         double f_timeout_d,
+                                         std::size_t f_maxOutput_i = 65536);
+  
+  // kill program and its child processes and wait for it
+  static void kill_vd(gType_PROCESS_Child_st& f_child_st);
+};
+
+#endif	/* CPROCESS_HPP */
@@ -0,0 +1,233 @@
+/**
+ * @file CPyramid.cpp
+ * @brief CPyramid class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Index of sorted data (x and y column) for windows of x values, see
+ *   CPyramid.hpp.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "CPyramid.hpp"
+#include "CException.hpp"
+#include "CParallel.hpp"
+
+// number of points of block (level 0), points of partial blocks are compared directly
+static const std::size_t g_blockSize_i = 32;
+
+
+// ========================================================================
+// CPyramid - constructor. Blocks are computed in parallel, each level
+// above merges pairs of nodes of level below.
+// ========================================================================
+CPyramid::CPyramid(const std::shared_ptr<const std::vector<double> >& f_dataX_p,
+                   const std::shared_ptr<const std::vector<double> >& f_dataY_p)
+  : m_dataX_p(f_dataX_p),
+    m_dataY_p(f_dataY_p),
+    m_valid_b(false)
+{
+  const std::vector<double>& l_dataX_v = *m_dataX_p;
+  const std::vector<double>& l_dataY_v = *m_dataY_p;
+  if (l_dataX_v.size() != l_dataY_v.size()) {
+    throw CException("CPyramid: data sizes must be the same.");
+  }
+  if (l_dataX_v.empty()) {
+    return;
+  }
+  
+  // x values are finite and sorted
+  std::vector<unsigned char> l_sorted_v(CParallel::numChunks_i(l_dataX_v.size()), 1);
+  CParallel::for_vd(l_dataX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int f_thread_i) {
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      if (!std::isfinite(l_dataX_v[l_k_i]) || ((l_k_i > 0) && (l_dataX_v[l_k_i] < l_dataX_v[l_k_i - 1]))) {
+        l_sorted_v[f_thread_i] = 0;
+        break;
+      }
+    }
+  });
+  if (std::find(l_sorted_v.begin(), l_sorted_v.end(), 0) != l_sorted_v.end()) {
+    return;
+  }
+  m_valid_b = true;
+  
+  // blocks of points
+  const std::size_t l_numBlocks_i = (l_dataX_v.size() + g_blockSize_i - 1) / g_blockSize_i;
+  m_level_v.push_back(std::vector<gType_PYRAMID_Node_st>(l_numBlocks_i));
+  std::vector<gType_PYRAMID_Node_st>& l_blocks_v = m_level_v.back();
+  CParallel::for_vd(l_numBlocks_i, [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+    for (std::size_t l_b_i = f_begin_i; l_b_i < f_end_i; ++l_b_i) {
+      gType_PYRAMID_Node_st& l_block_st = l_blocks_v[l_b_i];
+      l_block_st.min_i = l_dataY_v.size();
+      l_block_st.max_i = l_dataY_v.size();
+      l_block_st.gap_b = false;
+      m_addPoints_vd(l_block_st, l_b_i * g_blockSize_i, std::min(l_dataY_v.size(), (l_b_i + 1) * g_blockSize_i));
+    }
+  });
+  
+  // pairs of nodes, last node of odd level is taken over alone
+  while (m_level_v.back().size() > 1) {
+    const std::vector<gType_PYRAMID_Node_st>& l_below_v = m_level_v.back();
+    std::vector<gType_PYRAMID_Node_st> l_level_v((l_below_v.size() + 1) / 2);
+    for (std::size_t l_k_i = 0; l_k_i < l_level_v.size(); ++l_k_i) {
+      l_level_v[l_k_i] = l_below_v[2 * l_k_i];
+      if (2 * l_k_i + 1 < l_below_v.size()) {
+        m_merge_vd(l_level_v[l_k_i], l_below_v[2 * l_k_i + 1]);
+      }
+    }
+    m_level_v.push_back(l_level_v);
+  }
+}
+
+
+// ========================================================================
+// get points of window decimated to minimum and maximum of each bucket.
+// Borders of buckets are found by binary search, minimum and maximum of
+// bucket out of partial blocks at its borders and nodes of pyramid for
+// blocks in between.
+// ========================================================================
+void CPyramid::query_vd(double f_minX_d,
+                        double f_maxX_d,
+                        std::size_t f_buckets_i,
+                        std::vector<double>& f_dataX_v,
+                        std::vector<double>& f_dataY_v) const
+{
+  if (!m_valid_b) {
+    throw CException("CPyramid::query(): x values are not finite and sorted.");
+  }
+  const std::vector<double>& l_dataX_v = *m_dataX_p;
+  const std::vector<double>& l_dataY_v = *m_dataY_p;
+  f_dataX_v.clear();
+  f_dataY_v.clear();
+  
+  // points of window with last point before and first point after window
+  std::size_t l_begin_i = std::lower_bound(l_dataX_v.begin(), l_dataX_v.end(), f_minX_d) - l_dataX_v.begin();
+  std::size_t l_end_i = std::upper_bound(l_dataX_v.begin(), l_dataX_v.end(), f_maxX_d) - l_dataX_v.begin();
+  l_begin_i = (l_begin_i > 0) ? l_begin_i - 1 : 0;
+  l_end_i = std::max(l_begin_i, std::min(l_dataX_v.size(), l_end_i + 1));
+  if ((0 == f_buckets_i) || !(f_maxX_d > f_minX_d) || (l_end_i - l_begin_i <= 2 * f_buckets_i + 2)) {
+    f_dataX_v.assign(l_dataX_v.begin() + l_begin_i, l_dataX_v.begin() + l_end_i);
+    f_dataY_v.assign(l_dataY_v.begin() + l_begin_i, l_dataY_v.begin() + l_end_i);
+    return;
+  }
+  
+  f_dataX_v.reserve(3 * f_buckets_i + 2);
+  f_dataY_v.reserve(3 * f_buckets_i + 2);
+  f_dataX_v.push_back(l_dataX_v[l_begin_i]);
+  f_dataY_v.push_back(l_dataY_v[l_begin_i]);
+  const std::size_t l_last_i = l_end_i - 1;
+  std::size_t l_bucketBegin_i = l_begin_i + 1;
+  for (std::size_t l_b_i = 0; l_b_i < f_buckets_i; ++l_b_i) {
+    std::size_t l_bucketEnd_i = l_last_i;
+    if (l_b_i + 1 < f_buckets_i) {
+      const double l_border_d = f_minX_d + (f_maxX_d - f_minX_d) * (l_b_i + 1) / f_buckets_i;
+      l_bucketEnd_i = std::lower_bound(l_dataX_v.begin() + l_bucketBegin_i, l_dataX_v.begin() + l_last_i, l_border_d) - l_dataX_v.begin();
+    }
+    if (l_bucketBegin_i >= l_bucketEnd_i) {
+      continue;
+    }
+    // points which are not finite are kept as one gap per bucket
+    const gType_PYRAMID_Node_st l_node_st = m_getRange_st(l_bucketBegin_i, l_bucketEnd_i);
+    l_bucketBegin_i = l_bucketEnd_i;
+    if (l_node_st.gap_b) {
+      f_dataX_v.push_back(std::numeric_limits<double>::quiet_NaN());
+      f_dataY_v.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+    if (l_dataX_v.size() == l_node_st.min_i) {
+      continue;
+    }
+    const std::size_t l_first_i = std::min(l_node_st.min_i, l_node_st.max_i);
+    const std::size_t l_second_i = std::max(l_node_st.min_i, l_node_st.max_i);
+    f_dataX_v.push_back(l_dataX_v[l_first_i]);
+    f_dataY_v.push_back(l_dataY_v[l_first_i]);
+    if (l_second_i != l_first_i) {
+      f_dataX_v.push_back(l_dataX_v[l_second_i]);
+      f_dataY_v.push_back(l_dataY_v[l_second_i]);
+    }
+  }
+  f_dataX_v.push_back(l_dataX_v[l_last_i]);
+  f_dataY_v.push_back(l_dataY_v[l_last_i]);
+}
+
+
+// ========================================================================
+// get minimum and maximum of points [begin, end). Partial blocks at both
+// ends are compared point by point, full blocks in between are covered by
+// at most two nodes per level.
+// ========================================================================
+gType_PYRAMID_Node_st CPyramid::m_getRange_st(std::size_t f_begin_i, std::size_t f_end_i) const
+{
+  const std::vector<double>& l_dataY_v = *m_dataY_p;
+  gType_PYRAMID_Node_st l_node_st;
+  l_node_st.min_i = l_dataY_v.size();
+  l_node_st.max_i = l_dataY_v.size();
+  l_node_st.gap_b = false;
+  std::size_t l_firstBlock_i = (f_begin_i + g_blockSize_i - 1) / g_blockSize_i;
+  std::size_t l_lastBlock_i = f_end_i / g_blockSize_i;
+  if (m_level_v.empty() || (l_firstBlock_i >= l_lastBlock_i)) { // no full block
+    m_addPoints_vd(l_node_st, f_begin_i, f_end_i);
+    return l_node_st;
+  }
+  m_addPoints_vd(l_node_st, f_begin_i, l_firstBlock_i * g_blockSize_i);
+  m_addPoints_vd(l_node_st, l_lastBlock_i * g_blockSize_i, f_end_i);
+  for (std::size_t l_level_i = 0; (l_level_i < m_level_v.size()) && (l_firstBlock_i < l_lastBlock_i); ++l_level_i) {
+    const std::vector<gType_PYRAMID_Node_st>& l_nodes_v = m_level_v[l_level_i];
+    if (0 != (l_firstBlock_i & 1)) {
+      m_merge_vd(l_node_st, l_nodes_v[l_firstBlock_i++]);
+    }
+    if (0 != (l_lastBlock_i & 1)) {
+      m_merge_vd(l_node_st, l_nodes_v[--l_lastBlock_i]);
+    }
+    l_firstBlock_i /= 2;
+    l_lastBlock_i /= 2;
+  }
+  return l_node_st;
+}
+
+
+// ========================================================================
+// add points [begin, end) to minimum and maximum of node, first index wins
+// at equal values
+// ========================================================================
+void CPyramid::m_addPoints_vd(gType_PYRAMID_Node_st& f_node_st, std::size_t f_begin_i, std::size_t f_end_i) const
+{
+  const std::vector<double>& l_dataY_v = *m_dataY_p;
+  for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+    if (!std::isfinite(l_dataY_v[l_k_i])) {
+      f_node_st.gap_b = true;
+      continue;
+    }
+    if ((l_dataY_v.size() == f_node_st.min_i) || (l_dataY_v[l_k_i] < l_dataY_v[f_node_st.min_i])) {
+      f_node_st.min_i = l_k_i;
+    }
+    if ((l_dataY_v.size() == f_node_st.max_i) || (l_dataY_v[l_k_i] > l_dataY_v[f_node_st.max_i])) {
+      f_node_st.max_i = l_k_i;
+    }
+  }
+}
+
+
+// ========================================================================
+// add minimum and maximum of other node to node, first index wins at
+// equal values
+// ========================================================================
+void CPyramid::m_merge_vd(gType_PYRAMID_Node_st& f_node_st, const gType_PYRAMID_Node_st& f_other_st) const
+{
+  const std::vector<double>& l_dataY_v = *m_dataY_p;
+  const std::size_t l_none_i = l_dataY_v.size();
+  f_node_st.gap_b = f_node_st.gap_b || f_other_st.gap_b;
+  if ((l_none_i != f_other_st.min_i) &&
+      ((l_none_i == f_node_st.min_i) || (l_dataY_v[f_other_st.min_i] < l_dataY_v[f_node_st.min_i]) ||
+       ((l_dataY_v[f_other_st.min_i] == l_dataY_v[f_node_st.min_i]) && (f_other_st.min_i < f_node_st.min_i)))) {
+    f_node_st.min_i = f_other_st.min_i;
+  }
+  if ((l_none_i != f_other_st.max_i) &&
+      ((l_none_i == f_node_st.max_i) || (l_dataY_v[f_other_st.max_i] > l_dataY_v[f_node_st.max_i]) ||
+       ((l_dataY_v[f_other_st.max_i] == l_dataY_v[f_node_st.max_i]) && (f_other_st.max_i < f_node_st.max_i)))) {
+    f_node_st.max_i = f_other_st.max_i;
+  }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file CPyramid.hpp
+ * @brief CPyramid class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Index of sorted data (x and y column) for windows of x values. Minimum and
+ *   maximum of y values are kept for blocks of points and for each level of pairs of
+ *   blocks above (min/max pyramid). Index is built once, afterwards each window is
+ *   decimated to minimum and maximum per bucket (e.g. dot of plot width) in time
+ *   logarithmic in size of data, i.e. a zoom series needs no pass over all points.
+ *   Index is immutable and can be shared by several threads.
+ *
+ * usage:\n
+ * \code
+ * CPyramid l_pyramid_c(l_dataX_p, l_dataY_p);
+ * std::vector<double> l_windowX_v;
+ * std::vector<double> l_windowY_v;
+ * l_pyramid_c.query_vd(10.0, 20.0, 1000, l_windowX_v, l_windowY_v);
+ * \endcode
+ *
+ */
+
+#ifndef CPYRAMID_HPP
+#define	CPYRAMID_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// minimum and maximum of y values of points of block (finite points only)
+typedef struct C_PYRAMID_Node_st
+{
+  std::size_t min_i; // index of minimum, size of data when block has no finite point
+  std::size_t max_i; // index of maximum, size of data when block has no finite point
+  bool gap_b; // block contains point which is not finite
+} gType_PYRAMID_Node_st;
+
+class CPyramid {
+public:
+  
+  // build index of data columns. Data can only be queried when x values are finite and
+  // sorted (see valid_b), y values which are not finite are gaps.
+  CPyramid(const std::shared_ptr<const std::vector<double> >& f_dataX_p,
+           const std::shared_ptr<const std::vector<double> >& f_dataY_p);
+  
+  // x values are finite and sorted, i.e. data can be queried
+  bool valid_b() const
+  {
+    return m_valid_b;
+  }
+  
+  // index was built out of given columns
+  bool refersTo_b(const std::shared_ptr<const std::vector<double> >& f_dataX_p,
+                  const std::shared_ptr<const std::vector<double> >& f_dataY_p) const
+  {
+    return (m_dataX_p == f_dataX_p) && (m_dataY_p == f_dataY_p);
+  }
+  
+  // x values of index
+  const std::shared_ptr<const std::vector<double> >& getDataX_p() const
+  {
+    return m_dataX_p;
+  }
+  
+  // y values of index
+  const std::shared_ptr<const std::vector<double> >& getDataY_p() const
+  {
+    return m_dataY_p;
+  }
+  
+  // get points of window [minX, maxX] decimated to minimum and maximum of each bucket (equal
+  // width in x, order of points is kept, one gap per bucket). Last point before and first
+  // point after window are kept, i.e. lines leave plot at its border. Windows with at most
+  // about two points per bucket are not decimated.
+  void query_vd(double f_minX_d,
+                double f_maxX_d,
+                std::size_t f_buckets_i,
+                std::vector<double>& f_dataX_v,
+                std::vector<double>& f_dataY_v) const;
+  
+private:
+  
+  // get minimum and maximum of points [begin, end)
+  gType_PYRAMID_Node_st m_getRange_st(std::size_t f_begin_i, std::size_t f_end_i) const;
+  
+  // add points [begin, end) to minimum and maximum of node
+  void m_addPoints_vd(gType_PYRAMID_Node_st& f_node_st, std::size_t f_begin_i, std::size_t f_end_i) const;
+  
+  // add minimum and maximum of other node to node
+  void m_merge_vd(gType_PYRAMID_Node_st& f_node_st, const gType_PYRAMID_Node_st& f_other_st) const;
+  
+  std::shared_ptr<const std::vector<double> > m_dataX_p; // x values
+  std::shared_ptr<const std::vector<double> > m_dataY_p; // y values
+  bool m_valid_b; // x values are finite and sorted
+  std::vector<std::vector<gType_PYRAMID_Node_st> > m_level_v; // blocks (level 0) and pairs of nodes below
+};
+
+#endif	/* CPYRAMID_HPP */
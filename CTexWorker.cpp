@@ -0,0 +1,191 @@
+/**
+ * @file CTexWorker.cpp
+ * @brief CTexWorker class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Keeps a TeX engine running in the background which already processed the
+ *   preamble. For a PDF preview only the document body is fed into stdin of the
+ *   waiting engine.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "CTexWorker.hpp"
+#include "CException.hpp"
+#include "CFile.hpp"
+
+
+// ========================================================================
+// CTexWorker - constructor, engine is started with first compilation
+// ========================================================================
+CTexWorker::CTexWorker(const std::string& f_baseDir_s)
+{
+  m_dir_s = CFile::createTempDir_s(f_baseDir_s);
+  m_running_b = false;
+  m_job_i = 0;
+  m_child_st.pid_i = -1;
+  m_child_st.stdin_i = -1;
+  m_child_st.output_i = -1;
+}
+
+
+// ========================================================================
+// ~CTexWorker - destructor
+// ========================================================================
+CTexWorker::~CTexWorker()
+{
+  m_stop_vd();
+  CFile::removeDir_vd(m_dir_s);
+}
+
+
+// ========================================================================
+// compile document. Job files alternate between two names: the engine for
+// the next run is already started while files of the current run are
+// still used (aux file for second run, PDF and log file to be moved).
+// ========================================================================
+gType_PROCESS_Result_st CTexWorker::compile_st(const std::string& f_engine_s,
+                                               const std::string& f_preamble_s,
+                                               const std::string& f_body_s,
+                                               const std::string& f_filenamePdf_s,
+                                               const std::string& f_filenameLog_s,
+                                               double f_timeout_d)
+{
+  std::lock_guard<std::mutex> l_lock_c(m_mutex_c);
+  if (!m_running_b || (f_engine_s != m_engine_s) || (f_preamble_s != m_preamble_s)) {
+    m_stop_vd();
+    m_start_vd(f_engine_s, f_preamble_s);
+  }
+  
+  int l_job_i = m_job_i;
+  gType_PROCESS_Result_st l_result_st = m_run_st(f_body_s, f_timeout_d);
+  bool l_success_b = !l_result_st.timeout_b && (0 == l_result_st.exitCode_i);
+  if (l_success_b && m_running_b && m_needsRerun_b(l_job_i)) {
+    // aux file of first run is read by second run (references of labels)
+    const std::string l_aux_s = m_getJobBase_s(l_job_i) + ".aux";
+    if (CFile::exists_b(l_aux_s)) {
+      CFile::moveFile_vd(l_aux_s, m_getJobBase_s(m_job_i) + ".aux");
+    }
+    l_job_i = m_job_i;
+    l_result_st = m_run_st(f_body_s, f_timeout_d);
+    l_success_b = !l_result_st.timeout_b && (0 == l_result_st.exitCode_i);
+  }
+  
+  const std::string l_jobBase_s = m_getJobBase_s(l_job_i);
+  if (!l_success_b) {
+    // log file is kept for analysis
+    if (CFile::exists_b(l_jobBase_s + ".log")) {
+      CFile::moveFile_vd(l_jobBase_s + ".log", f_filenameLog_s);
+    }
+    return l_result_st;
+  }
+  if (!CFile::exists_b(l_jobBase_s + ".pdf")) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTexWorker::compile(): " << f_engine_s << " did not create PDF file \"" << f_filenamePdf_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  CFile::moveFile_vd(l_jobBase_s + ".pdf", f_filenamePdf_s);
+  return l_result_st;
+}
+
+
+// ========================================================================
+// start engine which reads document from stdin. Files of previous run of
+// this job are removed, i.e. no stale aux or PDF file is used.
+// ========================================================================
+void CTexWorker::m_start_vd(const std::string& f_engine_s, const std::string& f_preamble_s)
+{
+  m_job_i = 1 - m_job_i;
+  const std::string l_jobBase_s = m_getJobBase_s(m_job_i);
+  std::remove((l_jobBase_s + ".aux").c_str());
+  std::remove((l_jobBase_s + ".pdf").c_str());
+  std::remove((l_jobBase_s + ".log").c_str());
+  
+  std::stringstream l_jobName_ss;
+  l_jobName_ss << "-jobname=ctikzjob" << m_job_i;
+  std::vector<std::string> l_args_v;
+  l_args_v.push_back(f_engine_s);
+  l_args_v.push_back("-interaction=nonstopmode");
+  l_args_v.push_back("-halt-on-error");
+  l_args_v.push_back("--output-directory");
+  l_args_v.push_back(m_dir_s);
+  l_args_v.push_back(l_jobName_ss.str());
+  l_args_v.push_back("/dev/stdin");
+  m_child_st = CProcess::spawn_st(l_args_v, true);
+  m_running_b = true;
+  m_engine_s = f_engine_s;
+  m_preamble_s = f_preamble_s;
+  try {
+    CProcess::write_vd(m_child_st, f_preamble_s);
+  } catch (CException&) {
+    // engine stopped already, error is reported by result of run
+  }
+}
+
+
+// ========================================================================
+// kill waiting engine
+// ========================================================================
+void CTexWorker::m_stop_vd()
+{
+  if (m_running_b) {
+    CProcess::kill_vd(m_child_st);
+    m_running_b = false;
+  }
+}
+
+
+// ========================================================================
+// feed body into waiting engine and wait until it finishes. Next engine
+// is started immediately, it processes the preamble while caller handles
+// result of this run.
+// ========================================================================
+gType_PROCESS_Result_st CTexWorker::m_run_st(const std::string& f_body_s, double f_timeout_d)
+{
+  try {
+    CProcess::write_vd(m_child_st, f_body_s);
+  } catch (CException&) {
+    // engine stopped already (e.g. error in preamble), result tells why
+  }
+  CProcess::closeStdin_vd(m_child_st);
+  const gType_PROCESS_Result_st l_result_st = CProcess::wait_st(m_child_st, f_timeout_d);
+  m_running_b = false;
+  try {
+    m_start_vd(m_engine_s, m_preamble_s);
+  } catch (CException&) {
+    // engine is started again by next compilation, which reports error
+  }
+  return l_result_st;
+}
+
+
+// ========================================================================
+// file name of job without extension
+// ========================================================================
+std::string CTexWorker::m_getJobBase_s(int f_job_i)
+{
+  std::stringstream l_jobBase_ss;
+  l_jobBase_ss << m_dir_s << "ctikzjob" << f_job_i;
+  return l_jobBase_ss.str();
+}
+
+
+// ========================================================================
+// log file reports undefined references or changed labels
+// ========================================================================
+bool CTexWorker::m_needsRerun_b(int f_job_i)
+{
+  std::ifstream l_file_c((m_getJobBase_s(f_job_i) + ".log").c_str());
+  std::string l_line_s;
+  while (std::getline(l_file_c, l_line_s)) {
+    if ((std::string::npos != l_line_s.find("There were undefined references")) ||
+        (std::string::npos != l_line_s.find("Rerun to get"))) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file CTexWorker.hpp
+ * @brief CTexWorker class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Keeps a TeX engine running in the background which already processed the
+ *   preamble (document class, pgfplots etc.). For a PDF preview only the document body is
+ *   fed into stdin of the waiting engine, afterwards the next engine is started in advance.
+ *   Start up of engine and loading of packages is not part of the latency of a preview.
+ *   Engine is restarted when engine or preamble change. A worker can be shared by several
+ *   CTikz objects and threads, compilations are serialized.
+ *
+ * usage:\n
+ * \code
+ * std::shared_ptr<CTexWorker> l_worker_p = std::make_shared<CTexWorker>();
+ * l_tikz_c.setTexWorker_vd(l_worker_p);
+ * l_tikz_c.createTikzPdf_vd("plot1.tikz"); // starts engine
+ * l_tikz_c.createTikzPdf_vd("plot2.tikz"); // engine is already waiting for document body
+ * \endcode
+ *
+ */
+
+#ifndef CTEXWORKER_HPP
+#define	CTEXWORKER_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CProcess.hpp"
+
+class CTexWorker {
+public:
+  
+  // constructor, private working directory is created in given directory (see CFile::createTempDir_s)
+  CTexWorker(const std::string& f_baseDir_s = "");
+  
+  // destructor, kills waiting engine and removes working directory
+  ~CTexWorker();
+  
+  // compile document of preamble and body with engine (e.g. "pdflatex"). Body starts with
+  // \begin{document}. Engine runs a second time only when log file reports undefined
+  // references. PDF file is moved to given file, log file only when engine fails.
+  // Returns result of engine (timeout in seconds for each run, 0: no timeout).
+  gType_PROCESS_Result_st compile_st(const std::string& f_engine_s,
+                                     const std::string& f_preamble_s,
+                                     const std::string& f_body_s,
+                                     const std::string& f_filenamePdf_s,
+                                     const std::string& f_filenameLog_s,
+                                     double f_timeout_d);
+  
+private:
+  
+  // not copyable, engine and working directory belong to one worker
+  CTexWorker(const CTexWorker& f_orig_c) = delete;
+  CTexWorker& operator=(const CTexWorker& f_orig_c) = delete;
+  
+  std::mutex m_mutex_c; // serializes compilations
+  std::string m_dir_s; // private working directory, ends with "/"
+  std::string m_engine_s; // engine of waiting process
+  std::string m_preamble_s; // preamble already processed by waiting engine
+  bool m_running_b; // engine is waiting for document body
+  gType_PROCESS_Child_st m_child_st; // waiting engine
+  int m_job_i; // job of waiting engine, jobs alternate to keep files of previous run
+  
+  // start engine in advance and feed preamble
+  void m_start_vd(const std::string& f_engine_s, const std::string& f_preamble_s);
+  
+  // kill waiting engine
+  void m_stop_vd();
+  
+  // feed body into waiting engine and wait for it, next engine is started afterwards
+  gType_PROCESS_Result_st m_run_st(const std::string& f_body_s, double f_timeout_d);
+  
+  // file name of job without extension
+  std::string m_getJobBase_s(int f_job_i);
+  
+  // log file of job reports references which are resolved by second run
+  bool m_needsRerun_b(int f_job_i);
+};
+
+#endif	/* CTEXWORKER_HPP */
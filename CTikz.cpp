@@ -13,12 +13,189 @@
 
 
 #include <vector>
+#include <map>
 #include <fstream>
 #include <iostream>
 #include <ctime>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <atomic>
+#include <random>
 #include "CTikz.hpp"
 #include "CException.hpp"
+#include "CParallel.hpp"
+#include "CPyramid.hpp"
+#include "CFilter.hpp"
+#include "CPng.hpp"
+#include "CProcess.hpp"
+#include "CFile.hpp"
+#include "CTexWorker.hpp"
+
+// binary state file: magic, format version and marker to detect byte order
+static const char g_stateMagic_pc[8] = {'C', 'T', 'I', 'K', 'Z', 'B', 'I', 'N'};
+static const uint32_t g_stateVersion_i = 1;
+static const uint32_t g_stateByteOrder_i = 0x01020304;
+
+// index of column in column table of state file when data set entry has no such column
+static const uint64_t g_stateNoColumn_i = 0xFFFFFFFFFFFFFFFFULL;
+
+// counter of IDs of all objects
+static std::atomic<uint64_t> g_idCounter_i(0);
+
+// placeholder for ID of main axis in code of second axis, replaced when second axis is inserted
+static const char g_mainAxisId_pc[] = "ctikzMainAxis";
+
+// helper functions to write binary state file
+static void g_writeRaw_vd(std::string& f_buffer_s, const void* f_data_p, std::size_t f_size_i);
+static void g_writeU32_vd(std::string& f_buffer_s, uint32_t f_value_i);
+static void g_writeU64_vd(std::string& f_buffer_s, uint64_t f_value_i);
+static void g_writeDouble_vd(std::string& f_buffer_s, double f_value_d);
+static void g_writeString_vd(std::string& f_buffer_s, const std::string& f_value_s);
+static void g_writeStringVector_vd(std::string& f_buffer_s, const std::vector<std::string>& f_value_v);
+static void g_writeAlign_vd(std::string& f_buffer_s);
+static void g_addColumn_vd(const gType_TIKZ_Column_p& f_column_p,
+                           std::vector<const std::vector<double>*>& f_column_v,
+                           std::map<const std::vector<double>*, uint64_t>& f_index_m);
+static void g_writeColumnIndex_vd(std::string& f_buffer_s,
+                                  const gType_TIKZ_Column_p& f_column_p,
+                                  const std::map<const std::vector<double>*, uint64_t>& f_index_m);
+
+// reader for memory mapped binary state file, throws CException when file is truncated
+typedef struct C_TIKZ_StateReader_st
+{
+  const char* pos_p; // current read position
+  const char* begin_p; // begin of mapped file
+  const char* end_p; // end of mapped file
+} gType_TIKZ_StateReader_st;
+
+static const char* g_readRaw_p(gType_TIKZ_StateReader_st& f_reader_st, std::size_t f_size_i);
+static uint32_t g_readU32_i(gType_TIKZ_StateReader_st& f_reader_st);
+static uint64_t g_readU64_i(gType_TIKZ_StateReader_st& f_reader_st);
+static double g_readDouble_d(gType_TIKZ_StateReader_st& f_reader_st);
+static std::string g_readString_s(gType_TIKZ_StateReader_st& f_reader_st);
+static std::vector<std::string> g_readStringVector_v(gType_TIKZ_StateReader_st& f_reader_st);
+static void g_readAlign_vd(gType_TIKZ_StateReader_st& f_reader_st);
+static gType_TIKZ_Column_p g_readColumnIndex_p(gType_TIKZ_StateReader_st& f_reader_st,
+                                               const std::vector<gType_TIKZ_Column_p>& f_column_v);
+
+
+// quantile (linear interpolation between order statistics) of data. Quantiles
+// have to be requested in ascending order, f_begin is updated for next call.
+static double g_quantile_d(std::vector<double>& f_data_v, double f_p_d, std::size_t& f_begin_i);
+
+// running statistics of points of one bin (Welford), accumulators of parts of data are
+// merged pairwise (Chan et al.)
+typedef struct C_TIKZ_BinAccumulator_st
+{
+  uint64_t count_i; // number of points
+  double meanX_d; // mean of x values
+  double meanY_d; // mean of y values
+  double m2_d; // sum of squared deviations of y values from mean
+  double minX_d; // minimum x value
+  double maxX_d; // maximum x value
+} gType_TIKZ_BinAccumulator_st;
+
+// add accumulator of other part of data to accumulator
+static void g_mergeBin_vd(gType_TIKZ_BinAccumulator_st& f_bin_st, const gType_TIKZ_BinAccumulator_st& f_other_st);
+
+// weights of TeX cost estimation (unit: one coordinate of a plot without marks)
+static const double g_costPlot_d = 200; // each addplot
+static const double g_costMark_d = 3; // additional cost of a mark
+static const double g_costBand_d = 4; // coordinate of envelope band (paths and fill between)
+static const double g_costCell_d = 4; // cell of matrix plot
+
+// decimate sorted data to minimum and maximum of each bucket (index ranges of
+// equal size), first and last value are kept. y values are read in order out of
+// filter, i.e. filter stages run in same pass.
+static void g_decimateMinMax_vd(const std::vector<double>& f_dataX_v,
+                                CFilter& f_dataY_c,
+                                std::size_t f_buckets_i,
+                                std::vector<double>& f_decimatedX_v,
+                                std::vector<double>& f_decimatedY_v);
+
+// style of plot contains marks
+static bool g_hasMarks_b(const std::string& f_plotStyle_s);
+
+// add filters of data set entry as stages of filter, throws CException for invalid parameters
+// of filter
+static void g_addFilters_vd(CFilter& f_filter_c, const std::vector<gType_TIKZ_Filter_st>& f_filter_v);
+
+// write row of table (x and y value rounded and with significant digits of format) into buffer,
+// returns length of row
+static int g_formatRow_i(char* f_buffer_pc,
+                         std::size_t f_size_i,
+                         double f_x_d,
+                         double f_y_d,
+                         const gType_TIKZ_NumberFormat_st& f_formatX_st,
+                         const gType_TIKZ_NumberFormat_st& f_formatY_st);
+
+// write value (rounded and with significant digits of format) into buffer, returns length
+static int g_formatValue_i(char* f_buffer_pc,
+                           std::size_t f_size_i,
+                           double f_value_d,
+                           const gType_TIKZ_NumberFormat_st& f_format_st);
+
+// write row of table with y value only (x values of uniform grid are computed by pgfplots),
+// returns length of row
+static int g_formatRowY_i(char* f_buffer_pc,
+                          std::size_t f_size_i,
+                          double f_y_d,
+                          const gType_TIKZ_NumberFormat_st& f_formatY_st);
+
+// write row of table with x value, y value and error of y value (format of y values),
+// returns length of row
+static int g_formatRowError_i(char* f_buffer_pc,
+                              std::size_t f_size_i,
+                              double f_x_d,
+                              double f_y_d,
+                              double f_error_d,
+                              const gType_TIKZ_NumberFormat_st& f_formatX_st,
+                              const gType_TIKZ_NumberFormat_st& f_formatY_st);
+
+// get options of table of data set entry beginning with given row (row separator and x
+// expression of uniform grid)
+static std::string g_getTableOptions_s(const gType_TIKZ_DataSetCache_st& f_cache_st, std::size_t f_firstRow_i);
+
+// get x expression of pgfplots which computes x values of uniform grid from index of row
+static std::string g_getUniformExpr_s(double f_startX_d, double f_stepX_d);
+
+// write value like std::ostream with default format (6 significant digits, %g) without
+// temporary stream
+static std::string g_toString_s(double f_value_d);
+
+// write value with shortest representation which is read back exactly
+static std::string g_formatExact_s(double f_value_d);
+
+// get number of timestamps per second of unit
+static int64_t g_getUnitsPerSecond_i(gType_TIKZ_TimeUnit_e f_unit_e);
+
+// integer division rounding towards negative infinity
+static int64_t g_floorDiv_i(int64_t f_value_i, int64_t f_divisor_i);
+
+// data set entry is written as line plot with own table (no raster graphics, envelope, error bars or chunks)
+static bool g_isLineTable_b(const gType_TIKZ_DataSet_st& f_dataSet_st, std::size_t f_chunkSize_i);
+
+// get x column of data set entry, column of uniform grid is created
+static gType_TIKZ_Column_p g_getColumnX_p(const gType_TIKZ_DataSet_st& f_dataSet_st);
+
+// get column of filtered y values (temporary column for writers with random access), y values
+// of user when data set entry has no filter
+static gType_TIKZ_Column_p g_getColumnY_p(const gType_TIKZ_DataSet_st& f_dataSet_st);
+
+// colormap of 2D histogram (viridis), used for tikz colormap and raster graphics
+static const int g_colormapSize_i = 5;
+static const unsigned char g_colormap_ppi[g_colormapSize_i][3] = {{68, 1, 84}, {59, 82, 139}, {33, 145, 140}, {94, 201, 98}, {253, 231, 37}};
+
 
 // ========================================================================
 // CTikz - constructor
@@ -34,6 +211,74 @@ CTikz::CTikz()
 // ========================================================================
 CTikz::CTikz(const CTikz& f_orig_c)
 {
+  *this = f_orig_c;
+}
+
+
+// ========================================================================
+// copy assignment. Data columns and render caches are reference counted,
+// i.e. only pointers are copied. The object gets a new ID.
+// ========================================================================
+CTikz& CTikz::operator=(const CTikz& f_orig_c)
+{
+  if (this == &f_orig_c) {
+    return *this;
+  }
+  m_dataSet_v = f_orig_c.m_dataSet_v;
+  m_sharedTable_v = f_orig_c.m_sharedTable_v;
+  m_headerCache_s = f_orig_c.m_headerCache_s;
+  m_settingsDirty_b = f_orig_c.m_settingsDirty_b;
+  m_headerCacheType_e = f_orig_c.m_headerCacheType_e;
+  m_title_s = f_orig_c.m_title_s;
+  m_legend_v = f_orig_c.m_legend_v;
+  m_xLabel_s = f_orig_c.m_xLabel_s;
+  m_yLabel_s = f_orig_c.m_yLabel_s;
+  m_y2Label_s = f_orig_c.m_y2Label_s;
+  m_legendStyle_s = f_orig_c.m_legendStyle_s;
+  m_legendTitle_s = f_orig_c.m_legendTitle_s;
+  m_width_s = f_orig_c.m_width_s;
+  m_height_s = f_orig_c.m_height_s;
+  m_gridOnX_b = f_orig_c.m_gridOnX_b;
+  m_gridOnY_b = f_orig_c.m_gridOnY_b;
+  m_logOnX_b = f_orig_c.m_logOnX_b;
+  m_logOnY_b = f_orig_c.m_logOnY_b;
+  m_useAutoRangeX_b = f_orig_c.m_useAutoRangeX_b;
+  m_useAutoRangeY_b = f_orig_c.m_useAutoRangeY_b;
+  m_userdefinedMinX_d = f_orig_c.m_userdefinedMinX_d;
+  m_userdefinedMaxX_d = f_orig_c.m_userdefinedMaxX_d;
+  m_userdefinedMinY_d = f_orig_c.m_userdefinedMinY_d;
+  m_userdefinedMaxY_d = f_orig_c.m_userdefinedMaxY_d;
+  m_colorDefault_v = f_orig_c.m_colorDefault_v;
+  m_additionalSettings_v = f_orig_c.m_additionalSettings_v;
+  m_additionalsCommands_v = f_orig_c.m_additionalsCommands_v;
+  m_additionalsCommandsAfterBeginTikzPicture_v = f_orig_c.m_additionalsCommandsAfterBeginTikzPicture_v;
+  m_secondAxisCode_s = f_orig_c.m_secondAxisCode_s;
+  m_additionalLatexCommands_s = f_orig_c.m_additionalLatexCommands_s;
+  m_author_s = f_orig_c.m_author_s;
+  m_info_s = f_orig_c.m_info_s;
+  m_id_s = m_createId_s();
+  m_rasterResolution_d = f_orig_c.m_rasterResolution_d;
+  m_budgetMaxCost_d = f_orig_c.m_budgetMaxCost_d;
+  m_budget_e = f_orig_c.m_budget_e;
+  m_engine_e = f_orig_c.m_engine_e;
+  m_pdfTimeout_d = f_orig_c.m_pdfTimeout_d;
+  m_scratchDir_s = f_orig_c.m_scratchDir_s;
+  m_keepTex_b = f_orig_c.m_keepTex_b;
+  m_texWorker_p = f_orig_c.m_texWorker_p;
+  m_chunkSize_i = f_orig_c.m_chunkSize_i;
+  m_precision_e = f_orig_c.m_precision_e;
+  m_precisionValue_d = f_orig_c.m_precisionValue_d;
+  m_logPreprocess_b = f_orig_c.m_logPreprocess_b;
+  m_arena_b = f_orig_c.m_arena_b;
+  m_renderBuffer_s.clear(); // render buffer is not part of state, own capacity is kept
+  m_splitAxes_b = f_orig_c.m_splitAxes_b;
+  m_timeAxis_b = f_orig_c.m_timeAxis_b;
+  m_timeEpoch_i = f_orig_c.m_timeEpoch_i;
+  m_timeUnit_e = f_orig_c.m_timeUnit_e;
+  m_timeData_b = f_orig_c.m_timeData_b;
+  m_pyramid_b = f_orig_c.m_pyramid_b;
+  m_pyramidDpi_d = f_orig_c.m_pyramidDpi_d;
+  return *this;
 }
 
 
@@ -54,15 +299,16 @@ void CTikz::clear_vd()
   m_legend_v.clear();
   m_xLabel_s = "";
   m_yLabel_s = "";
+  m_y2Label_s = "";
   m_legendStyle_s = "draw=black,fill=white, legend cell align=left";
   m_width_s =  "10cm";
   m_height_s = "6cm";
-  m_dataSet_v.clear();
+  m_clearDataSet_vd();
   m_useAutoRangeX_b = true;
   m_useAutoRangeY_b = true;
   m_userdefinedMinX_d = 0;
   m_userdefinedMaxX_d = 0;
-  m_userdefinedMinX_d = 0;
+  m_userdefinedMinY_d = 0;
   m_userdefinedMaxY_d = 0;
   m_gridOnX_b = false;
   m_gridOnY_b = false;
@@ -76,6 +322,29 @@ void CTikz::clear_vd()
   m_info_s = "";
   m_id_s = m_createId_s();
   m_legendTitle_s = "";
+  m_headerCache_s = "";
+  m_settingsDirty_b = true;
+  m_headerCacheType_e = e_TIKZ_PlotTypeLine;
+  m_rasterResolution_d = 300;
+  m_budgetMaxCost_d = 0;
+  m_budget_e = e_TIKZ_BudgetOff;
+  m_engine_e = e_TIKZ_EnginePdflatex;
+  m_pdfTimeout_d = 300;
+  m_scratchDir_s = "";
+  m_keepTex_b = true;
+  m_texWorker_p.reset();
+  m_chunkSize_i = 0;
+  m_precision_e = e_TIKZ_PrecisionDefault;
+  m_precisionValue_d = 0;
+  m_logPreprocess_b = false;
+  m_arena_b = false;
+  std::string().swap(m_renderBuffer_s);
+  m_splitAxes_b = false;
+  m_timeAxis_b = false;
+  m_timeEpoch_i = 0;
+  m_timeUnit_e = e_TIKZ_TimeUnitSeconds;
+  m_pyramid_b = false;
+  m_pyramidDpi_d = 0;
   
   // set some default colors
   m_colorDefault_v.clear();
@@ -91,6 +360,7 @@ void CTikz::clear_vd()
 // ========================================================================
 void CTikz::setTitle_vd(const std::string& f_title_s)
 {
+  m_settingsDirty_b = true;
   m_title_s = f_title_s;
 }
 
@@ -111,6 +381,7 @@ void CTikz::setLegend_vd(const std::string& f_legend_s)
 void CTikz::addLegend_vd(const std::string& f_legend_s)
 {
   if ("" != f_legend_s) {
+    m_settingsDirty_b = true; // legend is used as labels of box plot
     m_legend_v.push_back(f_legend_s);
   }
 }
@@ -121,6 +392,7 @@ void CTikz::addLegend_vd(const std::string& f_legend_s)
 // ========================================================================
 void CTikz::setLegendTitle_vd(const std::string &f_legendTitle_s)
 {
+  m_settingsDirty_b = true;
   m_legendTitle_s = f_legendTitle_s;
 }
 
@@ -130,6 +402,7 @@ void CTikz::setLegendTitle_vd(const std::string &f_legendTitle_s)
 // ========================================================================
 void CTikz::setXlabel_vd(const std::string& f_xLabel_s)
 {
+  m_settingsDirty_b = true;
   m_xLabel_s = f_xLabel_s;
 }
 
@@ -139,10 +412,21 @@ void CTikz::setXlabel_vd(const std::string& f_xLabel_s)
 // ========================================================================
 void CTikz::setYlabel_vd(const std::string& f_yLabel_s)
 {
+  m_settingsDirty_b = true;
   m_yLabel_s = f_yLabel_s;
 }
 
 
+// ========================================================================
+// set label of second y axis
+// ========================================================================
+void CTikz::setY2label_vd(const std::string& f_y2Label_s)
+{
+  m_settingsDirty_b = true;
+  m_y2Label_s = f_y2Label_s;
+}
+
+
 // ========================================================================
 // set label for x and y axis
 // ========================================================================
@@ -166,7 +450,7 @@ void CTikz::setData_vd(const double *f_dataX_pd,
                        const std::string& f_plotStyle_s,
                        const std::string& f_legend_s)
 {
-  m_dataSet_v.clear();
+  m_clearDataSet_vd();
   m_legend_v.clear();
   addData_vd(f_dataX_pd, f_dataY_pd, f_size_i, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
 }
@@ -183,7 +467,7 @@ void CTikz::setData_vd(const std::vector<double>& f_dataX_v,
                        const std::string& f_plotStyle_s,
                        const std::string& f_legend_s)
 {
-  m_dataSet_v.clear();
+  m_clearDataSet_vd();
   m_legend_v.clear();
   addData_vd(f_dataX_v, f_dataY_v, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
 }
@@ -199,7 +483,7 @@ void CTikz::setData_vd(const std::vector<std::pair<double, double> >& f_data_v,
                        const std::string& f_plotStyle_s,
                        const std::string& f_legend_s)
 {
-  m_dataSet_v.clear();
+  m_clearDataSet_vd();
   m_legend_v.clear();
   addData_vd(f_data_v, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
 }
@@ -212,13 +496,35 @@ void CTikz::setData_vd(const std::vector<std::pair<double, double> >& f_data_v,
 void CTikz::setData_vd(const gType_TIKZ_DataSetEntry_st& f_dataSetEntry_st,
                        const std::string& f_legend_s)
 {
-  m_dataSet_v.clear();
-  m_dataSet_v.push_back(f_dataSetEntry_st);
+  m_clearDataSet_vd();
+  m_pushDataSet_vd(m_createDataSet_st(f_dataSetEntry_st));
   m_legend_v.clear();
   addLegend_vd(f_legend_s);
 }
 
 
+// ========================================================================
+// get data set
+// ========================================================================
+std::vector<gType_TIKZ_DataSetEntry_st> CTikz::v_getData() const
+{
+  std::vector<gType_TIKZ_DataSetEntry_st> l_data_v;
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = m_dataSet_v.begin(); l_dataSet_it != m_dataSet_v.end(); ++l_dataSet_it) {
+    gType_TIKZ_DataSetEntry_st l_dataSetEntry_st;
+    l_dataSetEntry_st.comment_s = l_dataSet_it->comment_s;
+    l_dataSetEntry_st.color_s = l_dataSet_it->color_s;
+    l_dataSetEntry_st.plotStyle_s = l_dataSet_it->plotStyle_s;
+    const gType_TIKZ_Column_p l_dataX_p = g_getColumnX_p(*l_dataSet_it);
+    l_dataSetEntry_st.data_v.reserve(l_dataX_p->size());
+    for (std::size_t l_k_i = 0; l_k_i < l_dataX_p->size(); ++l_k_i) {
+      l_dataSetEntry_st.data_v.push_back(std::make_pair((*l_dataX_p)[l_k_i], (*l_dataSet_it->y_p)[l_k_i]));
+    }
+    l_data_v.push_back(l_dataSetEntry_st);
+  }
+  return l_data_v;
+}
+
+
 // ========================================================================
 // add data via C array. size is size of array dataX and dataY.
 // additional: comment, color, plot style and legend entry can be set
@@ -236,14 +542,10 @@ void CTikz::addData_vd(const double *f_dataX_pd,
   }
   else
   {
-    std::vector<std::pair<double, double> > l_tmp_v;
-    for (int l_k_i = 0; l_k_i < f_size_i; ++l_k_i) {
-      std::pair<double, double> l_dataEntry_c = std::make_pair(*f_dataX_pd, *f_dataY_pd);
-      l_tmp_v.push_back(l_dataEntry_c);
-      ++f_dataX_pd;
-      ++f_dataY_pd;
-    }
-    addData_vd(l_tmp_v, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
+    const std::size_t l_size_i = (f_size_i > 0) ? f_size_i : 0;
+    gType_TIKZ_Column_p l_dataX_p = std::make_shared<const std::vector<double> >(f_dataX_pd, f_dataX_pd + l_size_i);
+    gType_TIKZ_Column_p l_dataY_p = std::make_shared<const std::vector<double> >(f_dataY_pd, f_dataY_pd + l_size_i);
+    m_addDataColumns_vd(l_dataX_p, l_dataY_p, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
   }
 }
 
@@ -258,18 +560,99 @@ void CTikz::addData_vd(const std::vector<double>& f_dataX_v,
                        const std::string& f_color_s,
                        const std::string& f_plotStyle_s,
                        const std::string& f_legend_s) {
-  std::vector<std::pair<double, double> > l_tmp_v;
   if (f_dataX_v.size() != f_dataY_v.size()) {
     std::stringstream l_msg_ss;
     l_msg_ss << "Data sizes must be the same. dataX.size()=" << f_dataX_v.size() << ", dataY.size()=" << f_dataY_v.size() << std::endl;
     throw CException(l_msg_ss);
-  } else {
-    for (size_t l_k_i = 0; l_k_i < f_dataX_v.size(); ++l_k_i) {
-      std::pair<double, double> l_dataEntry_c = std::make_pair(f_dataX_v.at(l_k_i), f_dataY_v.at(l_k_i));
-      l_tmp_v.push_back(l_dataEntry_c);
+  }
+  gType_TIKZ_Column_p l_dataX_p = std::make_shared<const std::vector<double> >(f_dataX_v);
+  gType_TIKZ_Column_p l_dataY_p = std::make_shared<const std::vector<double> >(f_dataY_v);
+  m_addDataColumns_vd(l_dataX_p, l_dataY_p, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
+}
+
+
+// ========================================================================
+// add data with uniform x values. Only start and step are stored, x column
+// is created when it is needed (raster graphics, histograms, decimation).
+// ========================================================================
+void CTikz::addDataUniform_vd(double f_startX_d,
+                              double f_stepX_d,
+                              const std::vector<double>& f_dataY_v,
+                              const std::string& f_comment_s,
+                              const std::string& f_color_s,
+                              const std::string& f_plotStyle_s,
+                              const std::string& f_legend_s)
+{
+  if (!(0 != f_stepX_d) || !std::isfinite(f_stepX_d) || !std::isfinite(f_startX_d)) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Invalid uniform grid. startX=" << f_startX_d << ", stepX=" << f_stepX_d << std::endl;
+    throw CException(l_msg_ss);
+  }
+  gType_TIKZ_Column_p l_dataY_p = std::make_shared<const std::vector<double> >(f_dataY_v);
+  m_addDataColumns_vd(gType_TIKZ_Column_p(), l_dataY_p, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
+  m_dataSet_v.back().startX_d = f_startX_d;
+  m_dataSet_v.back().stepX_d = f_stepX_d;
+}
+
+
+// ========================================================================
+// add data with timestamps. Difference to epoch is computed in integer
+// arithmetic, i.e. offsets are exact as long as they fit into mantissa.
+// ========================================================================
+void CTikz::addDataTime_vd(const std::vector<int64_t>& f_time_v,
+                           const std::vector<double>& f_dataY_v,
+                           const std::string& f_comment_s,
+                           const std::string& f_color_s,
+                           const std::string& f_plotStyle_s,
+                           const std::string& f_legend_s)
+{
+  if (!m_timeAxis_b) {
+    throw CException("CTikz::addDataTime(): time axis is not set (see setTimeAxis_vd).");
+  }
+  if (f_time_v.size() != f_dataY_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Data sizes must be the same. time.size()=" << f_time_v.size() << ", dataY.size()=" << f_dataY_v.size() << std::endl;
+    throw CException(l_msg_ss);
+  }
+  const double l_unitsPerSecond_d = static_cast<double>(g_getUnitsPerSecond_i(m_timeUnit_e));
+  std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >(f_time_v.size());
+  std::vector<double>& l_dataX_v = *l_dataX_p;
+  CParallel::for_vd(f_time_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      l_dataX_v[l_k_i] = static_cast<double>(f_time_v[l_k_i] - m_timeEpoch_i) / l_unitsPerSecond_d;
+    }
+  });
+  gType_TIKZ_Column_p l_dataY_p = std::make_shared<const std::vector<double> >(f_dataY_v);
+  m_addDataColumns_vd(l_dataX_p, l_dataY_p, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
+  m_timeData_b = true;
+}
+
+
+// ========================================================================
+// add several data set entries with common x values. All entries reference
+// the same x column.
+// ========================================================================
+void CTikz::addDataColumns_vd(const std::vector<double>& f_dataX_v,
+                              const std::vector<std::vector<double> >& f_dataY_v,
+                              const std::string& f_comment_s,
+                              const std::vector<std::string>& f_color_v,
+                              const std::string& f_plotStyle_s,
+                              const std::vector<std::string>& f_legend_v)
+{
+  for (std::size_t l_k_i = 0; l_k_i < f_dataY_v.size(); ++l_k_i) {
+    if (f_dataX_v.size() != f_dataY_v[l_k_i].size()) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "Data sizes must be the same. dataX.size()=" << f_dataX_v.size() << ", dataY[" << l_k_i << "].size()=" << f_dataY_v[l_k_i].size() << std::endl;
+      throw CException(l_msg_ss);
     }
   }
-  addData_vd(l_tmp_v, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
+  gType_TIKZ_Column_p l_dataX_p = std::make_shared<const std::vector<double> >(f_dataX_v);
+  for (std::size_t l_k_i = 0; l_k_i < f_dataY_v.size(); ++l_k_i) {
+    gType_TIKZ_Column_p l_dataY_p = std::make_shared<const std::vector<double> >(f_dataY_v[l_k_i]);
+    const std::string l_color_s = (l_k_i < f_color_v.size()) ? f_color_v[l_k_i] : "";
+    const std::string l_legend_s = (l_k_i < f_legend_v.size()) ? f_legend_v[l_k_i] : "";
+    m_addDataColumns_vd(l_dataX_p, l_dataY_p, f_comment_s, l_color_s, f_plotStyle_s, l_legend_s);
+  }
 }
 
 
@@ -283,30 +666,15 @@ void CTikz::addData_vd(const std::vector<std::pair<double, double> >& f_data_v,
                        const std::string& f_plotStyle_s,
                        const std::string& f_legend_s)
 {
-  if (f_data_v.empty()) {
-    throw CException("Empty data set.");
-  } else {
-    gType_TIKZ_DataSetEntry_st l_dataSetEntry_st;
-    l_dataSetEntry_st.data_v = f_data_v;
-    l_dataSetEntry_st.comment_s = f_comment_s;
-    // default plot style is "solid"
-    l_dataSetEntry_st.plotStyle_s=("" == f_plotStyle_s) ? "solid" : f_plotStyle_s;
-    
-    // when no color is given then use color from default list or black
-    if ("" == f_color_s) {
-      if (!m_colorDefault_v.empty()) {
-        l_dataSetEntry_st.color_s = m_colorDefault_v.front();
-        m_colorDefault_v.erase(m_colorDefault_v.begin());
-      } else {
-        l_dataSetEntry_st.color_s = "black";
-      }
-    } else {
-      l_dataSetEntry_st.color_s = f_color_s;
-    }
-    
-    m_dataSet_v.push_back(l_dataSetEntry_st);
-    addLegend_vd(f_legend_s);
+  std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >();
+  std::shared_ptr<std::vector<double> > l_dataY_p = std::make_shared<std::vector<double> >();
+  l_dataX_p->reserve(f_data_v.size());
+  l_dataY_p->reserve(f_data_v.size());
+  for (std::vector<std::pair<double, double> >::const_iterator l_data_it = f_data_v.begin(); l_data_it != f_data_v.end(); ++l_data_it) {
+    l_dataX_p->push_back(l_data_it->first);
+    l_dataY_p->push_back(l_data_it->second);
   }
+  m_addDataColumns_vd(l_dataX_p, l_dataY_p, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
 }
 
 
@@ -317,707 +685,4111 @@ void CTikz::addData_vd(const std::vector<std::pair<double, double> >& f_data_v,
 void CTikz::addData_vd(const gType_TIKZ_DataSetEntry_st& f_dataSetEntry_st,
                        const std::string& f_legend_s)
 {
-  m_dataSet_v.push_back(f_dataSetEntry_st);
+  m_pushDataSet_vd(m_createDataSet_st(f_dataSetEntry_st));
   addLegend_vd(f_legend_s);
 }
 
 
-
 // ========================================================================
-// set style for legend
+// add data columns as new data set entry
+// additional: comment, color, plot style and legend entry can be set
 // ========================================================================
-void CTikz::setLegendStyle_vd(const std::string& f_legendStyle_s)
+void CTikz::m_addDataColumns_vd(const gType_TIKZ_Column_p& f_dataX_p,
+                                const gType_TIKZ_Column_p& f_dataY_p,
+                                const std::string& f_comment_s,
+                                const std::string& f_color_s,
+                                const std::string& f_plotStyle_s,
+                                const std::string& f_legend_s,
+                                const gType_TIKZ_Column_p& f_lower_p /* = gType_TIKZ_Column_p() */,
+                                const gType_TIKZ_Column_p& f_upper_p /* = gType_TIKZ_Column_p() */,
+                                const gType_TIKZ_Column_p& f_error_p /* = gType_TIKZ_Column_p() */)
 {
-  m_legendStyle_s = f_legendStyle_s;
+  if (f_dataY_p->empty()) {
+    throw CException("Empty data set.");
+  } else {
+    gType_TIKZ_DataSet_st l_dataSet_st;
+    l_dataSet_st.x_p = f_dataX_p;
+    l_dataSet_st.startX_d = 0;
+    l_dataSet_st.stepX_d = 0;
+    l_dataSet_st.y_p = f_dataY_p;
+    l_dataSet_st.lower_p = f_lower_p;
+    l_dataSet_st.upper_p = f_upper_p;
+    l_dataSet_st.error_p = f_error_p;
+    l_dataSet_st.comment_s = f_comment_s;
+    l_dataSet_st.raster_b = false;
+    l_dataSet_st.rasterMarkSize_d = 1.0;
+    l_dataSet_st.secondAxis_b = false;
+    // default plot style is "solid"
+    l_dataSet_st.plotStyle_s=("" == f_plotStyle_s) ? "solid" : f_plotStyle_s;
+    
+    // when no color is given then use color from default list or black
+    if ("" == f_color_s) {
+      if (!m_colorDefault_v.empty()) {
+        l_dataSet_st.color_s = m_colorDefault_v.front();
+        m_colorDefault_v.erase(m_colorDefault_v.begin());
+      } else {
+        l_dataSet_st.color_s = "black";
+      }
+    } else {
+      l_dataSet_st.color_s = f_color_s;
+    }
+    
+    m_pushDataSet_vd(l_dataSet_st);
+    addLegend_vd(f_legend_s);
+  }
 }
 
 
 // ========================================================================
-// set width of plot
+// add envelope of runs sharing x values
 // ========================================================================
-void CTikz::setWidth_vd(const std::string& f_width_s)
+void CTikz::addEnvelope_vd(const std::vector<double>& f_dataX_v,
+                           const std::vector<std::vector<double> >& f_runsY_v,
+                           gType_TIKZ_Center_e f_center_e,
+                           double f_lowerPercentile_d,
+                           double f_upperPercentile_d,
+                           const std::string& f_comment_s,
+                           const std::string& f_color_s,
+                           const std::string& f_plotStyle_s,
+                           const std::string& f_legend_s)
 {
-  m_width_s = f_width_s;
+  std::vector<const std::vector<double>*> l_runsY_v;
+  for (std::size_t l_r_i = 0; l_r_i < f_runsY_v.size(); ++l_r_i) {
+    if (f_runsY_v[l_r_i].size() != f_dataX_v.size()) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "Data sizes must be the same. dataX.size()=" << f_dataX_v.size() << ", run " << l_r_i << ".size()=" << f_runsY_v[l_r_i].size();
+      throw CException(l_msg_ss.str());
+    }
+    l_runsY_v.push_back(&f_runsY_v[l_r_i]);
+  }
+  m_addEnvelope_vd(f_dataX_v, l_runsY_v, f_center_e, f_lowerPercentile_d, f_upperPercentile_d,
+                   f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
 }
 
 
 // ========================================================================
-// set height of plot
+// add envelope of runs with own x values, runs are resampled onto grid
 // ========================================================================
-void CTikz::setHeight_vd(const std::string& f_height_s)
+void CTikz::addEnvelope_vd(const std::vector<double>& f_gridX_v,
+                           const std::vector<std::vector<double> >& f_runsX_v,
+                           const std::vector<std::vector<double> >& f_runsY_v,
+                           gType_TIKZ_Center_e f_center_e,
+                           double f_lowerPercentile_d,
+                           double f_upperPercentile_d,
+                           const std::string& f_comment_s,
+                           const std::string& f_color_s,
+                           const std::string& f_plotStyle_s,
+                           const std::string& f_legend_s)
 {
-  m_height_s = f_height_s;
+  if (f_runsX_v.size() != f_runsY_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Number of runs must be the same. runsX.size()=" << f_runsX_v.size() << ", runsY.size()=" << f_runsY_v.size();
+    throw CException(l_msg_ss.str());
+  }
+  std::vector<std::vector<double> > l_resampled_v(f_runsY_v.size());
+  std::vector<const std::vector<double>*> l_runsY_v;
+  for (std::size_t l_r_i = 0; l_r_i < f_runsY_v.size(); ++l_r_i) {
+    const std::vector<double>& l_runX_v = f_runsX_v[l_r_i];
+    const std::vector<double>& l_runY_v = f_runsY_v[l_r_i];
+    if (l_runX_v.size() != l_runY_v.size()) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "Data sizes must be the same. run " << l_r_i << ": dataX.size()=" << l_runX_v.size() << ", dataY.size()=" << l_runY_v.size();
+      throw CException(l_msg_ss.str());
+    }
+    if (!std::is_sorted(l_runX_v.begin(), l_runX_v.end())) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "CTikz::addEnvelope(): x values of run " << l_r_i << " are not ascending.";
+      throw CException(l_msg_ss.str());
+    }
+    std::vector<double>& l_gridY_v = l_resampled_v[l_r_i];
+    l_gridY_v.assign(f_gridX_v.size(), std::numeric_limits<double>::quiet_NaN());
+    CParallel::for_vd(f_gridX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+      for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+        const double l_x_d = f_gridX_v[l_k_i];
+        std::vector<double>::const_iterator l_upper_it = std::lower_bound(l_runX_v.begin(), l_runX_v.end(), l_x_d);
+        if (l_upper_it == l_runX_v.end()) { // grid point behind run
+          continue;
+        }
+        const std::size_t l_idx_i = l_upper_it - l_runX_v.begin();
+        if (*l_upper_it == l_x_d) {
+          l_gridY_v[l_k_i] = l_runY_v[l_idx_i];
+        } else if (l_idx_i > 0) { // grid point in front of run is ignored
+          const double l_frac_d = (l_x_d - l_runX_v[l_idx_i - 1]) / (l_runX_v[l_idx_i] - l_runX_v[l_idx_i - 1]);
+          l_gridY_v[l_k_i] = l_runY_v[l_idx_i - 1] + l_frac_d * (l_runY_v[l_idx_i] - l_runY_v[l_idx_i - 1]);
+        }
+      }
+    });
+    l_runsY_v.push_back(&l_gridY_v);
+  }
+  m_addEnvelope_vd(f_gridX_v, l_runsY_v, f_center_e, f_lowerPercentile_d, f_upperPercentile_d,
+                   f_comment_s, f_color_s, f_plotStyle_s, f_legend_s);
 }
 
 
 // ========================================================================
-// create tikz file
+// compute center line and band of runs in parallel (each thread handles a
+// chunk of x values) and add envelope as data set entry
 // ========================================================================
-void CTikz::createTikzFile_vd(const std::string& f_filename_s)
+void CTikz::m_addEnvelope_vd(const std::vector<double>& f_dataX_v,
+                             const std::vector<const std::vector<double>*>& f_runsY_v,
+                             gType_TIKZ_Center_e f_center_e,
+                             double f_lowerPercentile_d,
+                             double f_upperPercentile_d,
+                             const std::string& f_comment_s,
+                             const std::string& f_color_s,
+                             const std::string& f_plotStyle_s,
+                             const std::string& f_legend_s)
 {
-  const bool l_createHist_b = false;
-  m_createTikzFile_vd(f_filename_s, l_createHist_b);
+  if (f_runsY_v.empty()) {
+    throw CException("CTikz::addEnvelope(): no runs given.");
+  }
+  if (!(0 <= f_lowerPercentile_d) || !(f_lowerPercentile_d <= f_upperPercentile_d) || !(f_upperPercentile_d <= 100)) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTikz::addEnvelope(): invalid percentiles " << f_lowerPercentile_d << " and " << f_upperPercentile_d << ".";
+    throw CException(l_msg_ss.str());
+  }
+  const std::size_t l_size_i = f_dataX_v.size();
+  std::shared_ptr<std::vector<double> > l_center_p = std::make_shared<std::vector<double> >(l_size_i);
+  std::shared_ptr<std::vector<double> > l_lower_p = std::make_shared<std::vector<double> >(l_size_i);
+  std::shared_ptr<std::vector<double> > l_upper_p = std::make_shared<std::vector<double> >(l_size_i);
+  CParallel::for_vd(l_size_i, [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+    std::vector<double> l_values_v;
+    l_values_v.reserve(f_runsY_v.size());
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      l_values_v.clear();
+      double l_sum_d = 0;
+      for (std::size_t l_r_i = 0; l_r_i < f_runsY_v.size(); ++l_r_i) {
+        const double l_y_d = (*f_runsY_v[l_r_i])[l_k_i];
+        if (std::isfinite(l_y_d)) {
+          l_values_v.push_back(l_y_d);
+          l_sum_d += l_y_d;
+        }
+      }
+      if (l_values_v.empty()) { // gap in all runs
+        (*l_center_p)[l_k_i] = (*l_lower_p)[l_k_i] = (*l_upper_p)[l_k_i] = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      std::size_t l_selBegin_i = 0;
+      const double l_lower_d = g_quantile_d(l_values_v, f_lowerPercentile_d / 100, l_selBegin_i);
+      double l_center_d = l_sum_d / l_values_v.size();
+      if (e_TIKZ_CenterMedian == f_center_e) { // median may be below lower percentile
+        std::size_t l_medianBegin_i = (f_lowerPercentile_d <= 50) ? l_selBegin_i : 0;
+        l_center_d = g_quantile_d(l_values_v, 0.5, l_medianBegin_i);
+        if (f_upperPercentile_d >= 50) {
+          l_selBegin_i = l_medianBegin_i;
+        }
+      }
+      (*l_lower_p)[l_k_i] = l_lower_d;
+      (*l_center_p)[l_k_i] = l_center_d;
+      (*l_upper_p)[l_k_i] = g_quantile_d(l_values_v, f_upperPercentile_d / 100, l_selBegin_i);
+    }
+  });
+  gType_TIKZ_Column_p l_dataX_p = std::make_shared<const std::vector<double> >(f_dataX_v);
+  m_addDataColumns_vd(l_dataX_p, l_center_p, f_comment_s, f_color_s, f_plotStyle_s, f_legend_s, l_lower_p, l_upper_p);
 }
 
 
 // ========================================================================
-// create tikz file as histogram graphics
+// add binned mean with error bars of standard error
 // ========================================================================
-void CTikz::createTikzFileHist_vd(const std::string& f_filename_s,
-                                  int f_bins_i,
-                                  double f_dataMin_d,
-                                  double f_dataMax_d)
+void CTikz::addBinnedMean_vd(const std::vector<double>& f_dataX_v,
+                             const std::vector<double>& f_dataY_v,
+                             std::size_t f_bins_i,
+                             gType_TIKZ_Binning_e f_binning_e,
+                             const std::string& f_comment_s,
+                             const std::string& f_color_s,
+                             const std::string& f_plotStyle_s,
+                             const std::string& f_legend_s)
 {
-  const bool l_createHist_b = true;
-  m_createTikzFile_vd(f_filename_s, l_createHist_b, f_bins_i, f_dataMin_d, f_dataMax_d);
+  const std::vector<gType_TIKZ_Bin_st> l_bins_v = getBins_v(f_dataX_v, f_dataY_v, f_bins_i, f_binning_e);
+  if (l_bins_v.empty()) {
+    throw CException("CTikz::addBinnedMean(): no finite point given.");
+  }
+  std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >();
+  std::shared_ptr<std::vector<double> > l_dataY_p = std::make_shared<std::vector<double> >();
+  std::shared_ptr<std::vector<double> > l_error_p = std::make_shared<std::vector<double> >();
+  for (std::vector<gType_TIKZ_Bin_st>::const_iterator l_bin_it = l_bins_v.begin(); l_bin_it != l_bins_v.end(); ++l_bin_it) {
+    l_dataX_p->push_back(l_bin_it->meanX_d);
+    l_dataY_p->push_back(l_bin_it->mean_d);
+    l_error_p->push_back(l_bin_it->stderr_d);
+  }
+  // default plot style: marks with error bars, no line
+  const std::string l_plotStyle_s = ("" == f_plotStyle_s) ? "only marks,mark=*" : f_plotStyle_s;
+  m_addDataColumns_vd(l_dataX_p, l_dataY_p, f_comment_s, f_color_s, l_plotStyle_s, f_legend_s,
+                      gType_TIKZ_Column_p(), gType_TIKZ_Column_p(), l_error_p);
 }
 
+
 // ========================================================================
-// creates tikz code which can used for a second axis in another CTikz object.
+// get statistics of bins of x values. Fixed bins need range of x values
+// first, quantile bins need borders out of sorted x values; statistics
+// are accumulated in one parallel pass afterwards.
 // ========================================================================
-void CTikz::createSecondAxisCode_vd(std::string& f_secondAxisCode_s)
+std::vector<gType_TIKZ_Bin_st> CTikz::getBins_v(const std::vector<double>& f_dataX_v,
+                                                const std::vector<double>& f_dataY_v,
+                                                std::size_t f_bins_i,
+                                                gType_TIKZ_Binning_e f_binning_e)
 {
-  std::stringstream l_Code_ss;
-  l_Code_ss << "\\begin{axis}[" << std::endl;
-  l_Code_ss << "yticklabel pos=right," << std::endl;
-  l_Code_ss << "xtick=\\empty," << std::endl;
-  l_Code_ss << "axis y line=right," << std::endl;
-  l_Code_ss << "y axis line style=-," << std::endl;
-  l_Code_ss << "width=" << m_width_s << "," << std::endl;
-  l_Code_ss << "height=" << m_height_s << "," << std::endl;
-  l_Code_ss << "scale only axis," << std::endl;
-  l_Code_ss << "xmin=" << m_getMinX_d() << "," << std::endl;
-  l_Code_ss << "xmax=" << m_getMaxX_d() << "," << std::endl;
-  l_Code_ss << "ylabel={" << m_yLabel_s << "}," << std::endl;
-  if (m_gridOnX_b) {
-    l_Code_ss << "xmajorgrids," << std::endl;
-  }
-  if (m_logOnX_b) {
-    l_Code_ss << "xmode=log,log basis x=10," << std::endl;
-  }
-  l_Code_ss << "ymin=" << m_getMinY_d() << "," << std::endl;
-  l_Code_ss << "ymax=" << m_getMaxY_d() << "," << std::endl;
-  if (m_gridOnY_b) {
-    l_Code_ss << "ymajorgrids," << std::endl;
-  }
-  if (m_logOnY_b) {
-    l_Code_ss << "ymode=log,log basis y=10," << std::endl;
+  if (f_dataX_v.size() != f_dataY_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Data sizes must be the same. dataX.size()=" << f_dataX_v.size() << ", dataY.size()=" << f_dataY_v.size();
+    throw CException(l_msg_ss.str());
   }
-  for (std::vector<std::string>::const_iterator l_settings_it = m_additionalSettings_v.begin();
-       l_settings_it != m_additionalSettings_v.end(); ++l_settings_it) {
-    l_Code_ss << *l_settings_it << "," << std::endl;
+  if (0 == f_bins_i) {
+    throw CException("CTikz::getBins(): number of bins must be positive.");
   }
-  l_Code_ss << "legend style={" << m_legendStyle_s << "}" << std::endl;
-  l_Code_ss << "]" << std::endl;
-  for (std::size_t l_k_i=0; l_k_i < m_legend_v.size() - m_dataSet_v.size(); ++l_k_i) {
-    l_Code_ss << "\\addlegendimage{/pgfplots/refstyle=addPlotLabel_" << m_id_s << "_" << l_k_i << "}" << std::endl;
-    l_Code_ss << "\\addlegendentry{" << m_legend_v.at(l_k_i) << "};" << std::endl;
+  auto l_finite_b = [&](std::size_t f_k_i) {
+    return std::isfinite(f_dataX_v[f_k_i]) && std::isfinite(f_dataY_v[f_k_i]);
+  };
+  
+  // range of x values (fixed bins) or inner borders of bins (quantile bins, ascending)
+  double l_minX_d = std::numeric_limits<double>::infinity();
+  double l_maxX_d = -std::numeric_limits<double>::infinity();
+  std::vector<double> l_border_v;
+  if (e_TIKZ_BinningQuantile == f_binning_e) {
+    std::vector<double> l_sorted_v;
+    l_sorted_v.reserve(f_dataX_v.size());
+    for (std::size_t l_k_i = 0; l_k_i < f_dataX_v.size(); ++l_k_i) {
+      if (l_finite_b(l_k_i)) {
+        l_sorted_v.push_back(f_dataX_v[l_k_i]);
+      }
+    }
+    // border b is order statistic b * size / bins, selected by halving ranges of borders (no
+    // complete sort): borders outside of range [first, last) are already at their position,
+    // values between them are selected behind border first - 1
+    auto l_position_i = [&](std::size_t f_border_i) {
+      return f_border_i * l_sorted_v.size() / f_bins_i;
+    };
+    std::vector<std::pair<std::size_t, std::size_t> > l_ranges_v(1, std::make_pair(std::size_t(1), f_bins_i));
+    while (!l_ranges_v.empty() && !l_sorted_v.empty()) {
+      const std::pair<std::size_t, std::size_t> l_range_st = l_ranges_v.back();
+      l_ranges_v.pop_back();
+      if (l_range_st.first >= l_range_st.second) {
+        continue;
+      }
+      const std::size_t l_middle_i = (l_range_st.first + l_range_st.second) / 2;
+      const std::size_t l_begin_i = l_position_i(l_range_st.first - 1) + ((l_range_st.first > 1) ? 1 : 0);
+      if (l_begin_i <= l_position_i(l_middle_i)) { // otherwise same value as border first - 1
+        std::nth_element(l_sorted_v.begin() + l_begin_i, l_sorted_v.begin() + l_position_i(l_middle_i),
+                         l_sorted_v.begin() + l_position_i(l_range_st.second));
+      }
+      l_ranges_v.push_back(std::make_pair(l_range_st.first, l_middle_i));
+      l_ranges_v.push_back(std::make_pair(l_middle_i + 1, l_range_st.second));
+    }
+    for (std::size_t l_b_i = 1; (l_b_i < f_bins_i) && !l_sorted_v.empty(); ++l_b_i) {
+      l_border_v.push_back(l_sorted_v[l_position_i(l_b_i)]);
+    }
+  } else {
+    std::vector<std::pair<double, double> > l_range_v(CParallel::numChunks_i(f_dataX_v.size()),
+                                                      std::make_pair(l_minX_d, l_maxX_d));
+    CParallel::for_vd(f_dataX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int f_thread_i) {
+      std::pair<double, double>& l_range_st = l_range_v[f_thread_i];
+      for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+        if (l_finite_b(l_k_i)) {
+          l_range_st.first = std::min(l_range_st.first, f_dataX_v[l_k_i]);
+          l_range_st.second = std::max(l_range_st.second, f_dataX_v[l_k_i]);
+        }
+      }
+    });
+    for (std::size_t l_t_i = 0; l_t_i < l_range_v.size(); ++l_t_i) {
+      l_minX_d = std::min(l_minX_d, l_range_v[l_t_i].first);
+      l_maxX_d = std::max(l_maxX_d, l_range_v[l_t_i].second);
+    }
   }
-  std::size_t l_legendIdx_i = m_dataSet_v.size();
-  for (std::vector<gType_TIKZ_DataSetEntry_st>::const_iterator l_dataSetEntry_it = m_dataSet_v.begin(); l_dataSetEntry_it != m_dataSet_v.end(); ++l_dataSetEntry_it) {
-    l_Code_ss << "\\addplot [color=" << l_dataSetEntry_it->color_s<< "," << l_dataSetEntry_it->plotStyle_s << "]" << std::endl;
-    l_Code_ss << "  table[row sep=crcr]{%" << std::endl;
-    for (std::vector<std::pair<double, double> >::const_iterator l_data_it = l_dataSetEntry_it->data_v.begin();
-         l_data_it != l_dataSetEntry_it->data_v.end();
-         ++l_data_it) {
-      l_Code_ss << l_data_it->first << "\t" << l_data_it->second << "\\\\" << std::endl;
+  const double l_scale_d = (l_maxX_d > l_minX_d) ? f_bins_i / (l_maxX_d - l_minX_d) : 0;
+  
+  // accumulators of each thread
+  gType_TIKZ_BinAccumulator_st l_empty_st;
+  l_empty_st.count_i = 0;
+  l_empty_st.meanX_d = 0;
+  l_empty_st.meanY_d = 0;
+  l_empty_st.m2_d = 0;
+  l_empty_st.minX_d = std::numeric_limits<double>::infinity();
+  l_empty_st.maxX_d = -std::numeric_limits<double>::infinity();
+  std::vector<std::vector<gType_TIKZ_BinAccumulator_st> > l_acc_v(CParallel::numChunks_i(f_dataX_v.size()));
+  CParallel::for_vd(f_dataX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int f_thread_i) {
+    std::vector<gType_TIKZ_BinAccumulator_st>& l_bins_v = l_acc_v[f_thread_i];
+    l_bins_v.assign(f_bins_i, l_empty_st);
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      if (!l_finite_b(l_k_i)) {
+        continue;
+      }
+      const double l_x_d = f_dataX_v[l_k_i];
+      const double l_y_d = f_dataY_v[l_k_i];
+      std::size_t l_bin_i = 0;
+      if (e_TIKZ_BinningQuantile == f_binning_e) {
+        l_bin_i = std::upper_bound(l_border_v.begin(), l_border_v.end(), l_x_d) - l_border_v.begin();
+      } else {
+        l_bin_i = std::min(f_bins_i - 1, static_cast<std::size_t>((l_x_d - l_minX_d) * l_scale_d));
+      }
+      gType_TIKZ_BinAccumulator_st& l_bin_st = l_bins_v[l_bin_i];
+      ++l_bin_st.count_i;
+      const double l_deltaY_d = l_y_d - l_bin_st.meanY_d;
+      l_bin_st.meanY_d += l_deltaY_d / l_bin_st.count_i;
+      l_bin_st.m2_d += l_deltaY_d * (l_y_d - l_bin_st.meanY_d);
+      l_bin_st.meanX_d += (l_x_d - l_bin_st.meanX_d) / l_bin_st.count_i;
+      l_bin_st.minX_d = std::min(l_bin_st.minX_d, l_x_d);
+      l_bin_st.maxX_d = std::max(l_bin_st.maxX_d, l_x_d);
     }
-    l_Code_ss << "};" << std::endl;
-    if (l_legendIdx_i < m_legend_v.size()) {
-      l_Code_ss << "\\addlegendentry{" << m_legend_v.at(l_legendIdx_i) << "};" << std::endl;
-      ++l_legendIdx_i;
+  });
+  
+  // merge accumulators of threads pairwise (tree), errors of merging stay small
+  for (std::size_t l_step_i = 1; l_step_i < l_acc_v.size(); l_step_i *= 2) {
+    for (std::size_t l_t_i = 0; l_t_i + l_step_i < l_acc_v.size(); l_t_i += 2 * l_step_i) {
+      for (std::size_t l_b_i = 0; l_b_i < f_bins_i; ++l_b_i) {
+        g_mergeBin_vd(l_acc_v[l_t_i][l_b_i], l_acc_v[l_t_i + l_step_i][l_b_i]);
+      }
     }
   }
-  l_Code_ss << std::endl;
-  for (std::vector<std::string>::iterator l_command_it = m_additionalsCommands_v.begin(); l_command_it != m_additionalsCommands_v.end(); ++l_command_it) {
-    l_Code_ss << *l_command_it << std::endl;
+  std::vector<gType_TIKZ_Bin_st> l_bins_v;
+  for (std::size_t l_b_i = 0; l_b_i < f_bins_i; ++l_b_i) {
+    const gType_TIKZ_BinAccumulator_st& l_acc_st = l_acc_v[0][l_b_i];
+    if (0 == l_acc_st.count_i) {
+      continue;
+    }
+    gType_TIKZ_Bin_st l_bin_st;
+    l_bin_st.minX_d = l_acc_st.minX_d;
+    l_bin_st.maxX_d = l_acc_st.maxX_d;
+    l_bin_st.count_i = l_acc_st.count_i;
+    l_bin_st.meanX_d = l_acc_st.meanX_d;
+    l_bin_st.mean_d = l_acc_st.meanY_d;
+    l_bin_st.stddev_d = (l_acc_st.count_i > 1) ? std::sqrt(l_acc_st.m2_d / (l_acc_st.count_i - 1)) : 0;
+    l_bin_st.stderr_d = l_bin_st.stddev_d / std::sqrt(static_cast<double>(l_acc_st.count_i));
+    l_bins_v.push_back(l_bin_st);
   }
-  l_Code_ss << std::endl;
-  l_Code_ss << "\\end{axis}" << std::endl;
-  f_secondAxisCode_s = l_Code_ss.str();
+  return l_bins_v;
 }
 
 
 // ========================================================================
-// // create tikz file and PDF file as preview with corresponding latex file
+// convert data set entry of user interface into internal representation
 // ========================================================================
-void CTikz::createTikzPdf_vd(const std::string& f_filenameTikz_s)
+gType_TIKZ_DataSet_st CTikz::m_createDataSet_st(const gType_TIKZ_DataSetEntry_st& f_dataSetEntry_st)
 {
-  createTikzFile_vd(f_filenameTikz_s);
-  
-  m_createPdf_vd(f_filenameTikz_s);
+  std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >();
+  std::shared_ptr<std::vector<double> > l_dataY_p = std::make_shared<std::vector<double> >();
+  l_dataX_p->reserve(f_dataSetEntry_st.data_v.size());
+  l_dataY_p->reserve(f_dataSetEntry_st.data_v.size());
+  for (std::vector<std::pair<double, double> >::const_iterator l_data_it = f_dataSetEntry_st.data_v.begin(); l_data_it != f_dataSetEntry_st.data_v.end(); ++l_data_it) {
+    l_dataX_p->push_back(l_data_it->first);
+    l_dataY_p->push_back(l_data_it->second);
+  }
+  gType_TIKZ_DataSet_st l_dataSet_st;
+  l_dataSet_st.x_p = l_dataX_p;
+  l_dataSet_st.startX_d = 0;
+  l_dataSet_st.stepX_d = 0;
+  l_dataSet_st.y_p = l_dataY_p;
+  l_dataSet_st.comment_s = f_dataSetEntry_st.comment_s;
+  l_dataSet_st.color_s = f_dataSetEntry_st.color_s;
+  l_dataSet_st.plotStyle_s = f_dataSetEntry_st.plotStyle_s;
+  l_dataSet_st.raster_b = false;
+  l_dataSet_st.rasterMarkSize_d = 1.0;
+  l_dataSet_st.secondAxis_b = false;
+  return l_dataSet_st;
 }
 
 
 // ========================================================================
-// create tikz file and PDF file as preview with corresponding latex file
-// graphics is generated as histogram// ========================================================================
-void CTikz::createTikzPdfHist_vd(const std::string& f_filenameTikz_s,
-                                 int f_bins_i,
-                                 double f_dataMin_d,
-                                 double f_dataMax_d)
+// render data set entry as raster graphics instead of table
+// ========================================================================
+void CTikz::setRaster_vd(std::size_t f_idx_i, bool f_on_b, double f_markSize_d)
 {
-  createTikzFileHist_vd(f_filenameTikz_s, f_bins_i, f_dataMin_d, f_dataMax_d);
-  
-  m_createPdf_vd(f_filenameTikz_s);
+  if (f_idx_i >= m_dataSet_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTikz::setRaster(): invalid data set index " << f_idx_i << ".";
+    throw CException(l_msg_ss.str());
+  }
+  gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  l_dataSet_st.raster_b = f_on_b;
+  l_dataSet_st.rasterMarkSize_d = f_markSize_d;
+  // table is not cached for raster graphics
+  l_dataSet_st.cache_p.reset();
 }
 
 
 // ========================================================================
-// set range for x axis of plot
+// append filter to filter stages of data set entry. Only settings are
+// kept, parameters are checked by adding stages to filter of y values.
 // ========================================================================
-void CTikz::setRangeX_vd(double f_minVal_d, double f_maxVal_d)
+void CTikz::addFilter_vd(std::size_t f_idx_i,
+                         gType_TIKZ_Filter_e f_filter_e,
+                         double f_value_d,
+                         unsigned int f_order_i)
 {
-  m_userdefinedMinX_d = f_minVal_d;
-  m_userdefinedMaxX_d = f_maxVal_d;
-  m_useAutoRangeX_b = false;
+  if (f_idx_i >= m_dataSet_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTikz::addFilter(): invalid data set index " << f_idx_i << ".";
+    throw CException(l_msg_ss.str());
+  }
+  gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  if (l_dataSet_st.lower_p || l_dataSet_st.error_p) {
+    throw CException("CTikz::addFilter(): envelopes and error bars cannot be filtered.");
+  }
+  gType_TIKZ_Filter_st l_filter_st;
+  l_filter_st.filter_e = f_filter_e;
+  l_filter_st.value_d = f_value_d;
+  l_filter_st.order_i = f_order_i;
+  CFilter l_filter_c(*l_dataSet_st.y_p);
+  g_addFilters_vd(l_filter_c, std::vector<gType_TIKZ_Filter_st>(1, l_filter_st));
+  l_dataSet_st.filter_v.push_back(l_filter_st);
+  // range of y axis changes, written tables and index of windows refer to unfiltered values
+  m_settingsDirty_b = true;
+  l_dataSet_st.cache_p.reset();
+  l_dataSet_st.pyramid_p.reset();
+  m_sharedTable_v.clear();
 }
 
 
 // ========================================================================
-// set range for y axis of plot
+// remove all filters of data set entry
 // ========================================================================
-void CTikz::setRangeY_vd(double f_minVal_d, double f_maxVal_d)
+void CTikz::clearFilter_vd(std::size_t f_idx_i)
 {
-  m_userdefinedMinY_d = f_minVal_d;
-  m_userdefinedMaxY_d = f_maxVal_d;
-  m_useAutoRangeY_b = false;
-}
-
-
+  if (f_idx_i >= m_dataSet_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTikz::clearFilter(): invalid data set index " << f_idx_i << ".";
+    throw CException(l_msg_ss.str());
+  }
+  gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  if (l_dataSet_st.filter_v.empty()) {
+    return;
+  }
+  l_dataSet_st.filter_v.clear();
+  m_settingsDirty_b = true;
+  l_dataSet_st.cache_p.reset();
+  l_dataSet_st.pyramid_p.reset();
+  m_sharedTable_v.clear();
+}
+
+
+// ========================================================================
+// plot data set entry on second y axis
+// ========================================================================
+void CTikz::setSecondAxis_vd(std::size_t f_idx_i, bool f_on_b)
+{
+  if (f_idx_i >= m_dataSet_v.size()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTikz::setSecondAxis(): invalid data set index " << f_idx_i << ".";
+    throw CException(l_msg_ss.str());
+  }
+  // range of first y axis changes, format of tables is checked when written
+  m_settingsDirty_b = true;
+  m_dataSet_v.at(f_idx_i).secondAxis_b = f_on_b;
+}
+
+
+// ========================================================================
+// set resolution of raster graphics in dots per inch
+// ========================================================================
+void CTikz::setRasterResolution_vd(double f_dpi_d)
+{
+  if (!(f_dpi_d > 0)) {
+    throw CException("CTikz::setRasterResolution(): resolution must be positive.");
+  }
+  m_rasterResolution_d = f_dpi_d;
+}
+
+
+// ========================================================================
+// set budget for estimated TeX cost of graphics
+// ========================================================================
+void CTikz::setBudget_vd(double f_maxCost_d, gType_TIKZ_Budget_e f_budget_e)
+{
+  if ((e_TIKZ_BudgetOff != f_budget_e) && !(f_maxCost_d > 0)) {
+    throw CException("CTikz::setBudget(): budget must be positive.");
+  }
+  m_budgetMaxCost_d = f_maxCost_d;
+  m_budget_e = f_budget_e;
+}
+
+
+// ========================================================================
+// estimated TeX cost of graphics (line plot of all data set entries)
+// ========================================================================
+double CTikz::estimateCost_d()
+{
+  return m_estimateCost_d(m_createPlotParam_st(e_TIKZ_PlotTypeLine), m_dataSet_v);
+}
+
+
+// ========================================================================
+// set TeX engine used to create PDF file
+// ========================================================================
+void CTikz::setEngine_vd(gType_TIKZ_Engine_e f_engine_e)
+{
+  m_engine_e = f_engine_e;
+}
+
+
+// ========================================================================
+// set directory in which scratch directories for compiling are created
+// ========================================================================
+void CTikz::setScratchDir_vd(const std::string& f_scratchDir_s)
+{
+  m_scratchDir_s = f_scratchDir_s;
+}
+
+
+// ========================================================================
+// set TeX worker used to create PDF files
+// ========================================================================
+void CTikz::setTexWorker_vd(const std::shared_ptr<CTexWorker>& f_texWorker_p)
+{
+  m_texWorker_p = f_texWorker_p;
+}
+
+
+// ========================================================================
+// keep latex file of PDF file next to tikz file
+// ========================================================================
+void CTikz::setKeepTex_vd(bool f_keepTex_b)
+{
+  m_keepTex_b = f_keepTex_b;
+}
+
+
+// ========================================================================
+// set timeout for each run of TeX engine
+// ========================================================================
+void CTikz::setPdfTimeout_vd(double f_timeout_d)
+{
+  if (!(f_timeout_d >= 0)) {
+    throw CException("CTikz::setPdfTimeout(): timeout must not be negative.");
+  }
+  m_pdfTimeout_d = f_timeout_d;
+}
+
+
+// ========================================================================
+// set maximum number of coordinates of one addplot command
+// ========================================================================
+void CTikz::setChunkSize_vd(std::size_t f_chunkSize_i)
+{
+  if (1 == f_chunkSize_i) {
+    throw CException("CTikz::setChunkSize(): chunks need at least two coordinates.");
+  }
+  m_chunkSize_i = f_chunkSize_i;
+}
+
+
+// ========================================================================
+// set precision of coordinates in tables, tables are recreated with next
+// tikz file
+// ========================================================================
+void CTikz::setPrecision_vd(gType_TIKZ_Precision_e f_precision_e, double f_value_d)
+{
+  if ((e_TIKZ_PrecisionDigits == f_precision_e) && ((f_value_d < 1) || (f_value_d > 17))) {
+    throw CException("CTikz::setPrecision(): number of significant digits must be between 1 and 17.");
+  }
+  if (f_value_d < 0) {
+    throw CException("CTikz::setPrecision(): dots per inch must not be negative.");
+  }
+  m_precision_e = f_precision_e;
+  m_precisionValue_d = f_value_d;
+}
+
+
+// ========================================================================
+// set time axis
+// ========================================================================
+void CTikz::setTimeAxis_vd(int64_t f_epoch_i, gType_TIKZ_TimeUnit_e f_unit_e)
+{
+  // offsets of data added before refer to epoch and unit
+  if (m_timeData_b && ((f_epoch_i != m_timeEpoch_i) || (f_unit_e != m_timeUnit_e))) {
+    throw CException("CTikz::setTimeAxis(): epoch and unit cannot be changed while data with timestamps exists.");
+  }
+  m_settingsDirty_b = true;
+  m_timeAxis_b = true;
+  m_timeEpoch_i = f_epoch_i;
+  m_timeUnit_e = f_unit_e;
+}
+
+
+// ========================================================================
+// write line plots within range of x axis only
+// ========================================================================
+void CTikz::setPyramid_vd(bool f_on_b, double f_dotsPerInch_d)
+{
+  if (f_dotsPerInch_d < 0) {
+    throw CException("CTikz::setPyramid(): dots per inch must not be negative.");
+  }
+  m_settingsDirty_b = true;
+  m_pyramid_b = f_on_b;
+  m_pyramidDpi_d = f_dotsPerInch_d;
+}
+
+
+// ========================================================================
+// set style for legend
+// ========================================================================
+void CTikz::setLegendStyle_vd(const std::string& f_legendStyle_s)
+{
+  m_settingsDirty_b = true;
+  m_legendStyle_s = f_legendStyle_s;
+}
+
+
+// ========================================================================
+// set width of plot
+// ========================================================================
+void CTikz::setWidth_vd(const std::string& f_width_s)
+{
+  m_settingsDirty_b = true;
+  m_width_s = f_width_s;
+}
+
+
+// ========================================================================
+// set height of plot
+// ========================================================================
+void CTikz::setHeight_vd(const std::string& f_height_s)
+{
+  m_settingsDirty_b = true;
+  m_height_s = f_height_s;
+}
+
+
+// ========================================================================
+// create tikz file
+// ========================================================================
+void CTikz::createTikzFile_vd(const std::string& f_filename_s)
+{
+  m_createTikzFile_vd(f_filename_s, m_createPlotParam_st(e_TIKZ_PlotTypeLine));
+}
+
+
+// ========================================================================
+// create tikz file as histogram graphics
+// ========================================================================
+void CTikz::createTikzFileHist_vd(const std::string& f_filename_s,
+                                  int f_bins_i,
+                                  double f_dataMin_d,
+                                  double f_dataMax_d)
+{
+  gType_TIKZ_PlotParam_st l_plotParam_st = m_createPlotParam_st(e_TIKZ_PlotTypeHist);
+  l_plotParam_st.bins_i = f_bins_i;
+  l_plotParam_st.dataMin_d = f_dataMin_d;
+  l_plotParam_st.dataMax_d = f_dataMax_d;
+  m_createTikzFile_vd(f_filename_s, l_plotParam_st);
+}
+
+
+// ========================================================================
+// create tikz file as 2D histogram (heatmap) of all data set entries
+// ========================================================================
+void CTikz::createTikzFileHist2d_vd(const std::string& f_filename_s,
+                                    int f_binsX_i,
+                                    int f_binsY_i,
+                                    bool f_raster_b)
+{
+  if ((f_binsX_i <= 0) || (f_binsY_i <= 0)) {
+    throw CException("CTikz::createTikzFileHist2d(): number of bins must be positive.");
+  }
+  gType_TIKZ_PlotParam_st l_plotParam_st = m_createPlotParam_st(e_TIKZ_PlotTypeHist2d);
+  l_plotParam_st.bins_i = f_binsX_i;
+  l_plotParam_st.binsY_i = f_binsY_i;
+  l_plotParam_st.raster_b = f_raster_b;
+  m_createTikzFile_vd(f_filename_s, l_plotParam_st);
+}
+
+// ========================================================================
+// creates tikz code which can used for a second axis in another CTikz object.
+// ========================================================================
+void CTikz::createSecondAxisCode_vd(std::string& f_secondAxisCode_s)
+{
+  std::stringstream l_Code_ss;
+  l_Code_ss << "\\begin{axis}[" << std::endl;
+  l_Code_ss << "yticklabel pos=right," << std::endl;
+  l_Code_ss << "xtick=\\empty," << std::endl;
+  l_Code_ss << "axis y line=right," << std::endl;
+  l_Code_ss << "y axis line style=-," << std::endl;
+  l_Code_ss << "width=" << m_width_s << "," << std::endl;
+  l_Code_ss << "height=" << m_height_s << "," << std::endl;
+  l_Code_ss << "scale only axis," << std::endl;
+  l_Code_ss << "xmin=" << m_getMinX_d() << "," << std::endl;
+  l_Code_ss << "xmax=" << m_getMaxX_d() << "," << std::endl;
+  l_Code_ss << "ylabel={" << m_yLabel_s << "}," << std::endl;
+  if (m_gridOnX_b) {
+    l_Code_ss << "xmajorgrids," << std::endl;
+  }
+  if (m_logOnX_b) {
+    l_Code_ss << "xmode=log,log basis x=10," << std::endl;
+  }
+  l_Code_ss << "ymin=" << m_getMinY_d() << "," << std::endl;
+  l_Code_ss << "ymax=" << m_getMaxY_d() << "," << std::endl;
+  if (m_gridOnY_b) {
+    l_Code_ss << "ymajorgrids," << std::endl;
+  }
+  if (m_logOnY_b) {
+    l_Code_ss << "ymode=log,log basis y=10," << std::endl;
+  }
+  for (std::vector<std::string>::const_iterator l_settings_it = m_additionalSettings_v.begin();
+       l_settings_it != m_additionalSettings_v.end(); ++l_settings_it) {
+    l_Code_ss << *l_settings_it << "," << std::endl;
+  }
+  l_Code_ss << "legend style={" << m_legendStyle_s << "}" << std::endl;
+  l_Code_ss << "]" << std::endl;
+  for (std::size_t l_k_i=0; l_k_i + m_dataSet_v.size() < m_legend_v.size(); ++l_k_i) {
+    l_Code_ss << "\\addlegendimage{/pgfplots/refstyle=addPlotLabel_" << g_mainAxisId_pc << "_" << l_k_i << "}" << std::endl;
+    l_Code_ss << "\\addlegendentry{" << m_legend_v.at(l_k_i) << "};" << std::endl;
+  }
+  std::string l_code_s = l_Code_ss.str();
+  const bool l_secondAxis_b = true;
+  // raster graphics of second axis are named after ID
+  const std::string l_filename_s = "ctikzSecondAxis_" + m_id_s + ".tikz";
+  m_writePlots_vd(l_code_s, l_filename_s, m_createPlotParam_st(e_TIKZ_PlotTypeLine), l_secondAxis_b);
+  l_code_s += "\n";
+  for (std::vector<std::string>::iterator l_command_it = m_additionalsCommands_v.begin(); l_command_it != m_additionalsCommands_v.end(); ++l_command_it) {
+    l_code_s += *l_command_it;
+    l_code_s += "\n";
+  }
+  l_code_s += "\n";
+  l_code_s += "\\end{axis}\n";
+  f_secondAxisCode_s.swap(l_code_s);
+}
+
+
+// ========================================================================
+// // create tikz file and PDF file as preview with corresponding latex file
+// ========================================================================
+void CTikz::createTikzPdf_vd(const std::string& f_filenameTikz_s)
+{
+  createTikzFile_vd(f_filenameTikz_s);
+  
+  m_createPdf_vd(f_filenameTikz_s);
+}
+
+
+// ========================================================================
+// create tikz file and PDF file as preview with corresponding latex file
+// graphics is generated as histogram// ========================================================================
+void CTikz::createTikzPdfHist_vd(const std::string& f_filenameTikz_s,
+                                 int f_bins_i,
+                                 double f_dataMin_d,
+                                 double f_dataMax_d)
+{
+  createTikzFileHist_vd(f_filenameTikz_s, f_bins_i, f_dataMin_d, f_dataMax_d);
+  
+  m_createPdf_vd(f_filenameTikz_s);
+}
+
+
+// ========================================================================
+// create tikz file and PDF file as preview with corresponding latex file
+// graphics is generated as 2D histogram (heatmap)
+// ========================================================================
+void CTikz::createTikzPdfHist2d_vd(const std::string& f_filenameTikz_s,
+                                   int f_binsX_i,
+                                   int f_binsY_i,
+                                   bool f_raster_b)
+{
+  createTikzFileHist2d_vd(f_filenameTikz_s, f_binsX_i, f_binsY_i, f_raster_b);
+  
+  m_createPdf_vd(f_filenameTikz_s);
+}
+
+
+// ========================================================================
+// create tikz file with box plot of each data set entry
+// ========================================================================
+void CTikz::createTikzFileBox_vd(const std::string& f_filename_s,
+                                 int f_maxOutliers_i)
+{
+  if (f_maxOutliers_i < 0) {
+    throw CException("CTikz::createTikzFileBox(): maximum number of outliers must not be negative.");
+  }
+  gType_TIKZ_PlotParam_st l_plotParam_st = m_createPlotParam_st(e_TIKZ_PlotTypeBox);
+  l_plotParam_st.maxOutliers_i = f_maxOutliers_i;
+  m_createTikzFile_vd(f_filename_s, l_plotParam_st);
+}
+
+
+// ========================================================================
+// create tikz file and PDF file as preview with corresponding latex file
+// graphics is generated as box plot
+// ========================================================================
+void CTikz::createTikzPdfBox_vd(const std::string& f_filenameTikz_s,
+                                int f_maxOutliers_i)
+{
+  createTikzFileBox_vd(f_filenameTikz_s, f_maxOutliers_i);
+  
+  m_createPdf_vd(f_filenameTikz_s);
+}
+
+
+// ========================================================================
+// set range for x axis of plot
+// ========================================================================
+void CTikz::setRangeX_vd(double f_minVal_d, double f_maxVal_d)
+{
+  m_settingsDirty_b = true;
+  m_userdefinedMinX_d = f_minVal_d;
+  m_userdefinedMaxX_d = f_maxVal_d;
+  m_useAutoRangeX_b = false;
+}
+
+
+// ========================================================================
+// set range for y axis of plot
+// ========================================================================
+void CTikz::setRangeY_vd(double f_minVal_d, double f_maxVal_d)
+{
+  m_settingsDirty_b = true;
+  m_userdefinedMinY_d = f_minVal_d;
+  m_userdefinedMaxY_d = f_maxVal_d;
+  m_useAutoRangeY_b = false;
+}
+
+
+// ========================================================================
+// set additional settings for tikz file (old settings are cleared)
+// ========================================================================
+void CTikz::setAdditionalSettings_vd(const std::string& f_settings_s)
+{
+  m_settingsDirty_b = true;
+  m_additionalSettings_v.clear();
+  addAdditionalSettings_vd(f_settings_s);
+}
+
+
+// ========================================================================
+// add additional settings for tikz file
+// ========================================================================
+void CTikz::addAdditionalSettings_vd(const std::string& f_settings_s)
+{
+  m_settingsDirty_b = true;
+  m_additionalSettings_v.push_back(f_settings_s);
+}
+
+
+// ========================================================================
+// set additional commands for tikz file (old settings are cleared)
+// ========================================================================
+void CTikz::setAdditionalCommands_vd(const std::string& f_command_s)
+{
+  m_additionalsCommands_v.clear();
+  addAdditionalCommands_vd(f_command_s);
+}
+
+
+// ========================================================================
+// add additional commands for tikz file
+// ========================================================================
+void CTikz::addAdditionalCommands_vd(const std::string &f_command_s)
+{
+  m_additionalsCommands_v.push_back(f_command_s);
+}
+
+
+// ========================================================================
+// // set additianl commands which are inserted after beginning of tikz picture
+// (old settings are cleared)
+// ========================================================================
+void CTikz::setAdditionalCommandsAfterBeginTikzePicture_vd(const std::string& f_command_s)
+{
+  m_settingsDirty_b = true;
+  m_additionalsCommandsAfterBeginTikzPicture_v.clear();
+  addAdditionalCommandsAfterBeginTikzePicture_vd(f_command_s);
+}
+
+
+// ========================================================================
+// // add additianl commands which are inserted after beginning of tikz picture
+// ========================================================================
+void CTikz::addAdditionalCommandsAfterBeginTikzePicture_vd(const std::string &f_command_s)
+{
+  m_settingsDirty_b = true;
+  m_additionalsCommandsAfterBeginTikzPicture_v.push_back(f_command_s);
+}
+
+
+// ========================================================================
+// add node in plot
+// ========================================================================
+void CTikz::addNode_vd(double f_posX_d,
+                       double f_posY_d,
+                       const std::string& f_text_s,
+                       const std::string& f_color_s,
+                       const std::string& f_anchor_s,
+                       double f_rotate_d,
+                       const std::string& f_font_s)
+{
+  std::string l_command_s;
+  l_command_s.reserve(96 + f_text_s.size() + f_color_s.size() + f_anchor_s.size() + f_font_s.size());
+  l_command_s += "\\node at (axis cs:" + g_toString_s(f_posX_d) + "," + g_toString_s(f_posY_d) + ") ";
+  l_command_s += "[text=" + f_color_s + ",anchor=" + f_anchor_s + ",rotate=";
+  l_command_s += g_toString_s(f_rotate_d) + ",font=\\" + f_font_s + "] {" + f_text_s + "};";
+  addAdditionalCommands_vd(l_command_s);
+}
+
+
+// ========================================================================
+// set on or off log scale of plot for x axis: default: on=true
+// ========================================================================
+void CTikz::setLogX_vd(bool f_on_b)
+{
+  m_settingsDirty_b = true;
+  m_logOnX_b = f_on_b;
+}
+
+
+// ========================================================================
+// set on or off log scale of plot for y axis: default: on=true
+// ========================================================================
+void CTikz::setLogY_vd(bool f_on_b)
+{
+  m_settingsDirty_b = true;
+  m_logOnY_b = f_on_b;
+}
+
+
+// ========================================================================
+// switch on or off arena mode, buffer is released when mode is switched off
+// ========================================================================
+void CTikz::setArena_vd(bool f_on_b)
+{
+  m_arena_b = f_on_b;
+  if (!m_arena_b) {
+    std::string().swap(m_renderBuffer_s);
+  }
+}
+
+
+// ========================================================================
+// set on or off computation of log10 of coordinates of log axes in C++
+// ========================================================================
+void CTikz::setLogPreprocessing_vd(bool f_on_b)
+{
+  m_settingsDirty_b = true;
+  m_logPreprocess_b = f_on_b;
+}
+
+
+// ========================================================================
+// switch on grid of plot
+// ========================================================================
+void CTikz::gridOn_vd() {
+  m_settingsDirty_b = true;
+  m_gridOnX_b = true;
+  m_gridOnY_b = true;
+}
+
+
+// ========================================================================
+// switch off grid of plot
+// ========================================================================
+void CTikz::gridOff_vd() {
+  m_settingsDirty_b = true;
+  m_gridOnX_b = false;
+  m_gridOnY_b = false;
+}
+
+
+// ========================================================================
+// set code for second axis
+// ========================================================================
+void CTikz::setSecondAxisCode_vd(const std::string& f_secondAxisCode_s)
+{
+  m_secondAxisCode_s = f_secondAxisCode_s;
+}
+
+
+// ========================================================================
+// set addional cammands which are only used for PDF preview generation, i.e. for latex code
+// (old latex commands are cleared)
+// ========================================================================
+void CTikz::setAdditionalLatexCommands_vd(const std::string& f_additionalLatexCommands_s)
+{
+  m_additionalLatexCommands_s = f_additionalLatexCommands_s;
+}
+
+
+// ========================================================================
+// add addional cammands which are only used for PDF preview generation, i.e. for latex code
+// ========================================================================
+void CTikz::addAdditionalLatexCommands_vd(const std::string& f_additionalLatexCommands_s)
+{
+  m_additionalLatexCommands_s += "\n";
+  m_additionalLatexCommands_s += f_additionalLatexCommands_s;
+}
+
+
+// ========================================================================
+// set author into tikz file
+// ========================================================================
+void CTikz::setAuthor_vd(const std::string& f_author_s)
+{
+  m_settingsDirty_b = true;
+  m_author_s = f_author_s;
+}
+
+
+// ========================================================================
+// set info into tikz file
+// ========================================================================
+void CTikz::setInfo_vd(const std::string& f_info_s)
+{
+  m_settingsDirty_b = true;
+  m_info_s = f_info_s;
+}
+
+
+// ========================================================================
+// save complete state into binary file.
+// layout: header, settings, column table, data set entries. Each column is
+// stored once as raw values aligned to 8 bytes, data set entries refer to
+// their columns by index, i.e. shared x columns are not repeated.
+// ========================================================================
+void CTikz::saveState_vd(const std::string& f_filename_s)
+{
+  if (m_fileExist_b(f_filename_s)) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "File \"" << f_filename_s << "\" already exists.";
+    throw CException(l_msg_ss.str());
+  }
+  std::size_t l_size_i = 4096;
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = m_dataSet_v.begin(); l_dataSet_it != m_dataSet_v.end(); ++l_dataSet_it) {
+    l_size_i += 2 * l_dataSet_it->y_p->size() * sizeof(double) + 256;
+  }
+  std::string l_buffer_s;
+  l_buffer_s.reserve(l_size_i);
+  
+  // header
+  g_writeRaw_vd(l_buffer_s, g_stateMagic_pc, sizeof(g_stateMagic_pc));
+  g_writeU32_vd(l_buffer_s, g_stateVersion_i);
+  g_writeU32_vd(l_buffer_s, g_stateByteOrder_i);
+  
+  // settings
+  g_writeString_vd(l_buffer_s, m_title_s);
+  g_writeStringVector_vd(l_buffer_s, m_legend_v);
+  g_writeString_vd(l_buffer_s, m_xLabel_s);
+  g_writeString_vd(l_buffer_s, m_yLabel_s);
+  g_writeString_vd(l_buffer_s, m_legendStyle_s);
+  g_writeString_vd(l_buffer_s, m_legendTitle_s);
+  g_writeString_vd(l_buffer_s, m_width_s);
+  g_writeString_vd(l_buffer_s, m_height_s);
+  uint32_t l_flags_i = 0;
+  l_flags_i |= m_gridOnX_b ? 0x01 : 0;
+  l_flags_i |= m_gridOnY_b ? 0x02 : 0;
+  l_flags_i |= m_logOnX_b ? 0x04 : 0;
+  l_flags_i |= m_logOnY_b ? 0x08 : 0;
+  l_flags_i |= m_useAutoRangeX_b ? 0x10 : 0;
+  l_flags_i |= m_useAutoRangeY_b ? 0x20 : 0;
+  g_writeU32_vd(l_buffer_s, l_flags_i);
+  g_writeDouble_vd(l_buffer_s, m_userdefinedMinX_d);
+  g_writeDouble_vd(l_buffer_s, m_userdefinedMaxX_d);
+  g_writeDouble_vd(l_buffer_s, m_userdefinedMinY_d);
+  g_writeDouble_vd(l_buffer_s, m_userdefinedMaxY_d);
+  g_writeStringVector_vd(l_buffer_s, m_colorDefault_v);
+  g_writeStringVector_vd(l_buffer_s, m_additionalSettings_v);
+  g_writeStringVector_vd(l_buffer_s, m_additionalsCommands_v);
+  g_writeStringVector_vd(l_buffer_s, m_additionalsCommandsAfterBeginTikzPicture_v);
+  g_writeString_vd(l_buffer_s, m_secondAxisCode_s);
+  g_writeString_vd(l_buffer_s, m_additionalLatexCommands_s);
+  g_writeString_vd(l_buffer_s, m_author_s);
+  g_writeString_vd(l_buffer_s, m_info_s);
+  g_writeDouble_vd(l_buffer_s, m_rasterResolution_d);
+  g_writeDouble_vd(l_buffer_s, m_budgetMaxCost_d);
+  g_writeU32_vd(l_buffer_s, static_cast<uint32_t>(m_budget_e));
+  g_writeU32_vd(l_buffer_s, static_cast<uint32_t>(m_engine_e));
+  g_writeU64_vd(l_buffer_s, m_chunkSize_i);
+  g_writeU32_vd(l_buffer_s, static_cast<uint32_t>(m_precision_e));
+  g_writeDouble_vd(l_buffer_s, m_precisionValue_d);
+  g_writeU32_vd(l_buffer_s, m_logPreprocess_b ? 1 : 0);
+  g_writeString_vd(l_buffer_s, m_y2Label_s);
+  g_writeU32_vd(l_buffer_s, m_timeAxis_b ? 1 : 0);
+  g_writeU64_vd(l_buffer_s, static_cast<uint64_t>(m_timeEpoch_i));
+  g_writeU32_vd(l_buffer_s, static_cast<uint32_t>(m_timeUnit_e));
+  g_writeU32_vd(l_buffer_s, m_timeData_b ? 1 : 0);
+  g_writeU32_vd(l_buffer_s, m_pyramid_b ? 1 : 0);
+  g_writeDouble_vd(l_buffer_s, m_pyramidDpi_d);
+  
+  // column table: each column is written once, also when it is shared by several data set entries
+  std::vector<const std::vector<double>*> l_column_v;
+  std::map<const std::vector<double>*, uint64_t> l_columnIndex_m;
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = m_dataSet_v.begin(); l_dataSet_it != m_dataSet_v.end(); ++l_dataSet_it) {
+    g_addColumn_vd(l_dataSet_it->x_p, l_column_v, l_columnIndex_m);
+    g_addColumn_vd(l_dataSet_it->y_p, l_column_v, l_columnIndex_m);
+    g_addColumn_vd(l_dataSet_it->lower_p, l_column_v, l_columnIndex_m);
+    g_addColumn_vd(l_dataSet_it->upper_p, l_column_v, l_columnIndex_m);
+    g_addColumn_vd(l_dataSet_it->error_p, l_column_v, l_columnIndex_m);
+  }
+  g_writeU64_vd(l_buffer_s, l_column_v.size());
+  for (std::vector<const std::vector<double>*>::const_iterator l_column_it = l_column_v.begin(); l_column_it != l_column_v.end(); ++l_column_it) {
+    g_writeU64_vd(l_buffer_s, (*l_column_it)->size());
+    g_writeAlign_vd(l_buffer_s);
+    if (!(*l_column_it)->empty()) {
+      g_writeRaw_vd(l_buffer_s, &(*l_column_it)->front(), (*l_column_it)->size() * sizeof(double));
+    }
+  }
+  
+  // data set entries refer to columns by index
+  g_writeU64_vd(l_buffer_s, m_dataSet_v.size());
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = m_dataSet_v.begin(); l_dataSet_it != m_dataSet_v.end(); ++l_dataSet_it) {
+    g_writeString_vd(l_buffer_s, l_dataSet_it->comment_s);
+    g_writeString_vd(l_buffer_s, l_dataSet_it->color_s);
+    g_writeString_vd(l_buffer_s, l_dataSet_it->plotStyle_s);
+    g_writeU32_vd(l_buffer_s, l_dataSet_it->raster_b ? 1 : 0);
+    g_writeDouble_vd(l_buffer_s, l_dataSet_it->rasterMarkSize_d);
+    g_writeU32_vd(l_buffer_s, l_dataSet_it->secondAxis_b ? 1 : 0);
+    g_writeU32_vd(l_buffer_s, static_cast<uint32_t>(l_dataSet_it->filter_v.size()));
+    for (std::vector<gType_TIKZ_Filter_st>::const_iterator l_filter_it = l_dataSet_it->filter_v.begin(); l_filter_it != l_dataSet_it->filter_v.end(); ++l_filter_it) {
+      g_writeU32_vd(l_buffer_s, static_cast<uint32_t>(l_filter_it->filter_e));
+      g_writeDouble_vd(l_buffer_s, l_filter_it->value_d);
+      g_writeU32_vd(l_buffer_s, l_filter_it->order_i);
+    }
+    g_writeDouble_vd(l_buffer_s, l_dataSet_it->startX_d);
+    g_writeDouble_vd(l_buffer_s, l_dataSet_it->stepX_d);
+    g_writeColumnIndex_vd(l_buffer_s, l_dataSet_it->x_p, l_columnIndex_m); // none: uniform grid
+    g_writeColumnIndex_vd(l_buffer_s, l_dataSet_it->y_p, l_columnIndex_m);
+    g_writeColumnIndex_vd(l_buffer_s, l_dataSet_it->lower_p, l_columnIndex_m);
+    g_writeColumnIndex_vd(l_buffer_s, l_dataSet_it->upper_p, l_columnIndex_m);
+    g_writeColumnIndex_vd(l_buffer_s, l_dataSet_it->error_p, l_columnIndex_m);
+  }
+  
+  std::ofstream l_file_c;
+  l_file_c.open(f_filename_s.c_str(), std::ios::out | std::ios::binary);
+  if (l_file_c) {
+    l_file_c.write(l_buffer_s.data(), l_buffer_s.size());
+  }
+  if (!l_file_c) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Cannot write into file \"" << f_filename_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  l_file_c.close();
+}
+
+
+// ========================================================================
+// load complete state from binary file. File is memory mapped, each column
+// of column table is copied once out of the mapping into its own vector and
+// shared by all data set entries which refer to it.
+// ========================================================================
+void CTikz::loadState_vd(const std::string& f_filename_s)
+{
+  int l_fd_i = open(f_filename_s.c_str(), O_RDONLY);
+  if (l_fd_i < 0) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Cannot open file \"" << f_filename_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  struct stat l_stat_st;
+  if ((0 != fstat(l_fd_i, &l_stat_st)) || (l_stat_st.st_size <= 0)) {
+    close(l_fd_i);
+    std::stringstream l_msg_ss;
+    l_msg_ss << "File \"" << f_filename_s << "\" is empty or cannot be read.";
+    throw CException(l_msg_ss.str());
+  }
+  const std::size_t l_size_i = static_cast<std::size_t>(l_stat_st.st_size);
+  void* l_map_p = mmap(0, l_size_i, PROT_READ, MAP_PRIVATE, l_fd_i, 0);
+  close(l_fd_i);
+  if (MAP_FAILED == l_map_p) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Cannot map file \"" << f_filename_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  
+  // parse into a new object first, i.e. current state is kept on error
+  CTikz l_tikz_c;
+  try {
+    gType_TIKZ_StateReader_st l_reader_st;
+    l_reader_st.begin_p = static_cast<const char*>(l_map_p);
+    l_reader_st.pos_p = l_reader_st.begin_p;
+    l_reader_st.end_p = l_reader_st.begin_p + l_size_i;
+    
+    // header
+    if (0 != std::memcmp(g_readRaw_p(l_reader_st, sizeof(g_stateMagic_pc)), g_stateMagic_pc, sizeof(g_stateMagic_pc))) {
+      throw CException("CTikz::loadState(): file is no CTikz state file.");
+    }
+    const uint32_t l_version_i = g_readU32_i(l_reader_st);
+    if (g_stateVersion_i != l_version_i) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "CTikz::loadState(): unsupported file version " << l_version_i << ".";
+      throw CException(l_msg_ss.str());
+    }
+    if (g_stateByteOrder_i != g_readU32_i(l_reader_st)) {
+      throw CException("CTikz::loadState(): file was written with different byte order.");
+    }
+    
+    // settings
+    l_tikz_c.m_title_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_legend_v = g_readStringVector_v(l_reader_st);
+    l_tikz_c.m_xLabel_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_yLabel_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_legendStyle_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_legendTitle_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_width_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_height_s = g_readString_s(l_reader_st);
+    const uint32_t l_flags_i = g_readU32_i(l_reader_st);
+    l_tikz_c.m_gridOnX_b = (0 != (l_flags_i & 0x01));
+    l_tikz_c.m_gridOnY_b = (0 != (l_flags_i & 0x02));
+    l_tikz_c.m_logOnX_b = (0 != (l_flags_i & 0x04));
+    l_tikz_c.m_logOnY_b = (0 != (l_flags_i & 0x08));
+    l_tikz_c.m_useAutoRangeX_b = (0 != (l_flags_i & 0x10));
+    l_tikz_c.m_useAutoRangeY_b = (0 != (l_flags_i & 0x20));
+    l_tikz_c.m_userdefinedMinX_d = g_readDouble_d(l_reader_st);
+    l_tikz_c.m_userdefinedMaxX_d = g_readDouble_d(l_reader_st);
+    l_tikz_c.m_userdefinedMinY_d = g_readDouble_d(l_reader_st);
+    l_tikz_c.m_userdefinedMaxY_d = g_readDouble_d(l_reader_st);
+    l_tikz_c.m_colorDefault_v = g_readStringVector_v(l_reader_st);
+    l_tikz_c.m_additionalSettings_v = g_readStringVector_v(l_reader_st);
+    l_tikz_c.m_additionalsCommands_v = g_readStringVector_v(l_reader_st);
+    l_tikz_c.m_additionalsCommandsAfterBeginTikzPicture_v = g_readStringVector_v(l_reader_st);
+    l_tikz_c.m_secondAxisCode_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_additionalLatexCommands_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_author_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_info_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_rasterResolution_d = g_readDouble_d(l_reader_st);
+    l_tikz_c.m_budgetMaxCost_d = g_readDouble_d(l_reader_st);
+    const uint32_t l_budget_i = g_readU32_i(l_reader_st);
+    if (l_budget_i > e_TIKZ_BudgetReduce) {
+      throw CException("CTikz::loadState(): invalid budget handling.");
+    }
+    l_tikz_c.m_budget_e = static_cast<gType_TIKZ_Budget_e>(l_budget_i);
+    const uint32_t l_engine_i = g_readU32_i(l_reader_st);
+    if (l_engine_i > e_TIKZ_EngineXelatex) {
+      throw CException("CTikz::loadState(): invalid TeX engine.");
+    }
+    l_tikz_c.m_engine_e = static_cast<gType_TIKZ_Engine_e>(l_engine_i);
+    l_tikz_c.m_chunkSize_i = static_cast<std::size_t>(g_readU64_i(l_reader_st));
+    const uint32_t l_precision_i = g_readU32_i(l_reader_st);
+    if (l_precision_i > e_TIKZ_PrecisionAxis) {
+      throw CException("CTikz::loadState(): invalid precision.");
+    }
+    l_tikz_c.m_precision_e = static_cast<gType_TIKZ_Precision_e>(l_precision_i);
+    l_tikz_c.m_precisionValue_d = g_readDouble_d(l_reader_st);
+    l_tikz_c.m_logPreprocess_b = (0 != g_readU32_i(l_reader_st));
+    l_tikz_c.m_y2Label_s = g_readString_s(l_reader_st);
+    l_tikz_c.m_timeAxis_b = (0 != g_readU32_i(l_reader_st));
+    l_tikz_c.m_timeEpoch_i = static_cast<int64_t>(g_readU64_i(l_reader_st));
+    const uint32_t l_unit_i = g_readU32_i(l_reader_st);
+    if (l_unit_i > e_TIKZ_TimeUnitNanoseconds) {
+      throw CException("CTikz::loadState(): invalid unit of time axis.");
+    }
+    l_tikz_c.m_timeUnit_e = static_cast<gType_TIKZ_TimeUnit_e>(l_unit_i);
+    l_tikz_c.m_timeData_b = (0 != g_readU32_i(l_reader_st));
+    l_tikz_c.m_pyramid_b = (0 != g_readU32_i(l_reader_st));
+    l_tikz_c.m_pyramidDpi_d = g_readDouble_d(l_reader_st);
+    
+    // column table, each column is copied once out of mapping
+    const uint64_t l_numColumns_i = g_readU64_i(l_reader_st);
+    std::vector<gType_TIKZ_Column_p> l_column_v;
+    for (uint64_t l_k_i = 0; l_k_i < l_numColumns_i; ++l_k_i) {
+      const uint64_t l_numData_i = g_readU64_i(l_reader_st);
+      g_readAlign_vd(l_reader_st);
+      if (l_numData_i > static_cast<uint64_t>(l_reader_st.end_p - l_reader_st.pos_p) / sizeof(double)) {
+        throw CException("CTikz::loadState(): file is truncated.");
+      }
+      const double* l_data_pd = reinterpret_cast<const double*>(g_readRaw_p(l_reader_st, l_numData_i * sizeof(double)));
+      l_column_v.push_back(std::make_shared<const std::vector<double> >(l_data_pd, l_data_pd + l_numData_i));
+    }
+    
+    // data set entries
+    const uint64_t l_numDataSetEntries_i = g_readU64_i(l_reader_st);
+    for (uint64_t l_k_i = 0; l_k_i < l_numDataSetEntries_i; ++l_k_i) {
+      gType_TIKZ_DataSet_st l_dataSet_st;
+      l_dataSet_st.comment_s = g_readString_s(l_reader_st);
+      l_dataSet_st.color_s = g_readString_s(l_reader_st);
+      l_dataSet_st.plotStyle_s = g_readString_s(l_reader_st);
+      l_dataSet_st.raster_b = (0 != g_readU32_i(l_reader_st));
+      l_dataSet_st.rasterMarkSize_d = g_readDouble_d(l_reader_st);
+      l_dataSet_st.secondAxis_b = (0 != g_readU32_i(l_reader_st));
+      const uint32_t l_numFilters_i = g_readU32_i(l_reader_st);
+      for (uint32_t l_f_i = 0; l_f_i < l_numFilters_i; ++l_f_i) {
+        gType_TIKZ_Filter_st l_filter_st;
+        const uint32_t l_filter_i = g_readU32_i(l_reader_st);
+        if (l_filter_i > e_TIKZ_FilterSavitzkyGolay) {
+          throw CException("CTikz::loadState(): invalid filter.");
+        }
+        l_filter_st.filter_e = static_cast<gType_TIKZ_Filter_e>(l_filter_i);
+        l_filter_st.value_d = g_readDouble_d(l_reader_st);
+        l_filter_st.order_i = g_readU32_i(l_reader_st);
+        l_dataSet_st.filter_v.push_back(l_filter_st);
+      }
+      l_dataSet_st.startX_d = g_readDouble_d(l_reader_st);
+      l_dataSet_st.stepX_d = g_readDouble_d(l_reader_st);
+      l_dataSet_st.x_p = g_readColumnIndex_p(l_reader_st, l_column_v);
+      l_dataSet_st.y_p = g_readColumnIndex_p(l_reader_st, l_column_v);
+      l_dataSet_st.lower_p = g_readColumnIndex_p(l_reader_st, l_column_v);
+      l_dataSet_st.upper_p = g_readColumnIndex_p(l_reader_st, l_column_v);
+      l_dataSet_st.error_p = g_readColumnIndex_p(l_reader_st, l_column_v);
+      if (!l_dataSet_st.y_p || (l_dataSet_st.x_p && (l_dataSet_st.x_p->size() != l_dataSet_st.y_p->size())) ||
+          (!l_dataSet_st.lower_p != !l_dataSet_st.upper_p) ||
+          (l_dataSet_st.lower_p && ((l_dataSet_st.lower_p->size() != l_dataSet_st.y_p->size()) || (l_dataSet_st.upper_p->size() != l_dataSet_st.y_p->size()))) ||
+          (l_dataSet_st.error_p && (l_dataSet_st.error_p->size() != l_dataSet_st.y_p->size()))) {
+        throw CException("CTikz::loadState(): columns of data set entry do not match.");
+      }
+      if (!l_dataSet_st.filter_v.empty()) { // check parameters of filters
+        CFilter l_filter_c(*l_dataSet_st.y_p);
+        g_addFilters_vd(l_filter_c, l_dataSet_st.filter_v);
+      }
+      l_tikz_c.m_pushDataSet_vd(l_dataSet_st);
+    }
+  } catch (...) {
+    munmap(l_map_p, l_size_i);
+    throw;
+  }
+  munmap(l_map_p, l_size_i);
+  
+  // take over loaded state, ID and runtime configuration (not part of stored state) are kept
+  l_tikz_c.m_pdfTimeout_d = m_pdfTimeout_d;
+  l_tikz_c.m_scratchDir_s = m_scratchDir_s;
+  l_tikz_c.m_keepTex_b = m_keepTex_b;
+  l_tikz_c.m_texWorker_p = m_texWorker_p;
+  l_tikz_c.m_arena_b = m_arena_b;
+  const std::string l_id_s = m_id_s;
+  *this = l_tikz_c;
+  m_id_s = l_id_s;
+}
+
+
+// ========================================================================
+//  create tikz file (used for histogram and non histogram)
+// ========================================================================
+void CTikz::m_createTikzFile_vd(const std::string& f_filename_s,
+                                const gType_TIKZ_PlotParam_st& f_plotParam_st)
+{
+  if (m_fileExist_b(f_filename_s)) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "File \"" << f_filename_s << "\" already exists.";
+    throw CException(l_msg_ss.str());
+  }
+  // render buffer keeps its capacity for next file in arena mode
+  std::string l_buffer_s;
+  std::string& l_tikz_s = m_arena_b ? m_renderBuffer_s : l_buffer_s;
+  l_tikz_s.clear();
+  m_createTikzCode_vd(l_tikz_s, f_filename_s, f_plotParam_st);
+  
+  std::ofstream l_file_c;
+  l_file_c.open(f_filename_s.c_str());
+  if (l_file_c) {
+    l_file_c.write(l_tikz_s.data(), l_tikz_s.size());
+    l_tikz_s.clear();
+  } else {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Cannot write into file \"" << f_filename_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  l_file_c.close();
+}
+
+
+// ========================================================================
+// append tikz code to given string. Only dirty data set entries are reformatted,
+// all other tables are spliced in from the render cache. Code of panel of
+// group plot contains only nextgroupplot command and plots.
+// ========================================================================
+void CTikz::m_createTikzCode_vd(std::string& f_tikz_s,
+                                const std::string& f_filename_s,
+                                const gType_TIKZ_PlotParam_st& f_plotParam_st)
+{
+  // log10 of coordinates, data set entries cut to window of x axis and data set entries
+  // reduced to fit into budget replace data set entries of user while code is created
+  // (bounds of reduced data set entries are unchanged, bounds of cut data set entries are
+  // bounds of window)
+  gType_TIKZ_LogSettings_st l_logSettings_st;
+  bool l_logTransform_b = false;
+  std::vector<gType_TIKZ_DataSet_st> l_dataSetWindow_v;
+  bool l_window_b = false;
+  std::vector<gType_TIKZ_DataSet_st> l_dataSetReduced_v;
+  bool l_reduced_b = false;
+  std::string& l_tikz_s = f_tikz_s;
+  // data set entries of second y axis are written into own axis after first axis
+  m_splitAxes_b = false;
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    m_splitAxes_b = m_splitAxes_b || m_dataSet_v[l_k_i].secondAxis_b;
+  }
+  m_splitAxes_b = m_splitAxes_b && (e_TIKZ_PlotTypeLine == f_plotParam_st.type_e) && !f_plotParam_st.groupPanel_b;
+  try {
+    l_logTransform_b = m_beginLogTransform_b(f_plotParam_st, l_logSettings_st);
+    l_window_b = m_applyWindow_b(f_plotParam_st, l_dataSetWindow_v);
+    if (l_window_b) {
+      m_dataSet_v.swap(l_dataSetWindow_v);
+    }
+    l_reduced_b = m_applyBudget_b(f_plotParam_st, l_dataSetReduced_v);
+    if (l_reduced_b) {
+      m_dataSet_v.swap(l_dataSetReduced_v);
+    }
+    const std::string l_panelHeader_s = f_plotParam_st.groupPanel_b ? m_getPanelHeader_s(f_plotParam_st) : "";
+    const std::string& l_header_s = f_plotParam_st.groupPanel_b ? l_panelHeader_s : m_getHeader_s(f_plotParam_st.type_e);
+    if (e_TIKZ_PlotTypeHist2d == f_plotParam_st.type_e) { // tables of data set entries are not used
+      l_tikz_s.reserve(l_tikz_s.size() + l_header_s.size() + m_secondAxisCode_s.size() + 1024);
+      l_tikz_s += l_header_s;
+      m_writeHist2d_vd(l_tikz_s, f_filename_s, f_plotParam_st);
+    } else if (e_TIKZ_PlotTypeBox == f_plotParam_st.type_e) { // only summary of data set entries
+      l_tikz_s += l_header_s;
+      m_writeBox_vd(l_tikz_s, f_plotParam_st);
+    } else {
+      // refresh caches first to be able to reserve the complete output at once
+      std::size_t l_size_i = l_tikz_s.size() + l_header_s.size() + m_secondAxisCode_s.size() + 1024;
+      const bool l_createHist_b = (e_TIKZ_PlotTypeHist == f_plotParam_st.type_e);
+      for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+        if (l_createHist_b || !m_isSharedX_b(l_k_i)) { // common tables are created while writing
+          l_size_i += m_getCache_st(l_k_i).table_s.size();
+        }
+        l_size_i += 256;
+      }
+      l_tikz_s.reserve(l_size_i);
+      l_tikz_s += l_header_s;
+      if (l_reduced_b) {
+        l_tikz_s += "% data reduced to fit into TeX cost budget\n";
+      }
+      const bool l_secondAxis_b = false;
+      m_writePlots_vd(l_tikz_s, f_filename_s, f_plotParam_st, l_secondAxis_b);
+    }
+    
+    l_tikz_s += "\n";
+    for (std::vector<std::string>::iterator l_commands_it = m_additionalsCommands_v.begin(); l_commands_it != m_additionalsCommands_v.end(); ++l_commands_it) {
+      l_tikz_s += *l_commands_it;
+      l_tikz_s += "\n";
+    }
+    l_tikz_s += "\n";
+    if (!f_plotParam_st.groupPanel_b) {
+      l_tikz_s += "\\end{axis}\n";
+      if (m_splitAxes_b) {
+        m_writeSecondAxis_vd(l_tikz_s, f_filename_s, f_plotParam_st);
+      }
+    }
+  } catch (...) {
+    if (l_reduced_b) {
+      m_dataSet_v.swap(l_dataSetReduced_v);
+    }
+    if (l_window_b) {
+      m_dataSet_v.swap(l_dataSetWindow_v);
+    }
+    if (l_reduced_b || l_window_b) { // cached header refers to replaced data set entries (auto range)
+      m_settingsDirty_b = true;
+    }
+    if (l_logTransform_b) {
+      m_endLogTransform_vd(l_logSettings_st);
+    }
+    m_splitAxes_b = false;
+    throw;
+  }
+  if (l_reduced_b) {
+    m_dataSet_v.swap(l_dataSetReduced_v);
+  }
+  if (l_window_b) {
+    m_dataSet_v.swap(l_dataSetWindow_v);
+  }
+  if (l_reduced_b || l_window_b) { // cached header refers to replaced data set entries (auto range)
+    m_settingsDirty_b = true;
+  }
+  if (l_logTransform_b) {
+    m_endLogTransform_vd(l_logSettings_st);
+  }
+  m_splitAxes_b = false;
+  
+  if (f_plotParam_st.groupPanel_b) { // group plot continues with next panel
+    return;
+  }
+  // insert second axis of other object, its legend images refer to labels of plots of this axis
+  const std::string l_placeholder_s = std::string("addPlotLabel_") + g_mainAxisId_pc + "_";
+  std::string::size_type l_pos_i = 0;
+  for (std::string::size_type l_found_i = m_secondAxisCode_s.find(l_placeholder_s); std::string::npos != l_found_i;
+       l_found_i = m_secondAxisCode_s.find(l_placeholder_s, l_pos_i)) {
+    l_tikz_s.append(m_secondAxisCode_s, l_pos_i, l_found_i - l_pos_i);
+    l_tikz_s += "addPlotLabel_" + m_id_s + "_";
+    l_pos_i = l_found_i + l_placeholder_s.size();
+  }
+  l_tikz_s.append(m_secondAxisCode_s, l_pos_i, std::string::npos);
+  l_tikz_s += "\\end{tikzpicture}%\n";
+}
+
+
+// ========================================================================
+// estimate TeX cost of graphics: each addplot has a fixed cost, each
+// coordinate costs one unit (more for marks and envelope bands). Raster
+// graphics and 2D histograms as raster graphics have fixed cost only.
+// ========================================================================
+double CTikz::m_estimateCost_d(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                               const std::vector<gType_TIKZ_DataSet_st>& f_dataSet_v)
+{
+  if (e_TIKZ_PlotTypeHist2d == f_plotParam_st.type_e) {
+    return g_costPlot_d + (f_plotParam_st.raster_b ? 0 : g_costCell_d * f_plotParam_st.bins_i * f_plotParam_st.binsY_i);
+  }
+  double l_cost_d = 0;
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = f_dataSet_v.begin(); l_dataSet_it != f_dataSet_v.end(); ++l_dataSet_it) {
+    const double l_costPoint_d = 1 + (g_hasMarks_b(l_dataSet_it->plotStyle_s) ? g_costMark_d : 0);
+    const double l_size_d = static_cast<double>(l_dataSet_it->y_p->size());
+    l_cost_d += g_costPlot_d;
+    if (e_TIKZ_PlotTypeBox == f_plotParam_st.type_e) {
+      l_cost_d += l_costPoint_d * std::min(l_size_d, static_cast<double>(f_plotParam_st.maxOutliers_i));
+    } else if (e_TIKZ_PlotTypeHist == f_plotParam_st.type_e) {
+      l_cost_d += l_size_d;
+    } else {
+      if (!l_dataSet_it->raster_b) {
+        l_cost_d += l_costPoint_d * l_size_d;
+      }
+      if (l_dataSet_it->lower_p) {
+        l_cost_d += 2 * g_costPlot_d + g_costBand_d * l_size_d;
+      }
+      if (l_dataSet_it->error_p) { // error bar costs about as much as a mark
+        l_cost_d += g_costMark_d * l_size_d;
+      }
+    }
+  }
+  return l_cost_d;
+}
+
+
+// ========================================================================
+// replace data set entries by log10 of coordinates of log axes (values
+// which are not positive become gaps, common columns stay common) and log
+// axes by linear axes. Render caches of user (header and common tables) are
+// kept aside.
+// ========================================================================
+bool CTikz::m_beginLogTransform_b(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                                  gType_TIKZ_LogSettings_st& f_settings_st)
+{
+  const bool l_logX_b = m_logPreprocess_b && m_logOnX_b && !(f_plotParam_st.groupPanel_b && f_plotParam_st.sharedX_b);
+  const bool l_logY_b = m_logPreprocess_b && m_logOnY_b && !(f_plotParam_st.groupPanel_b && f_plotParam_st.sharedY_b);
+  if ((e_TIKZ_PlotTypeLine != f_plotParam_st.type_e) || (!l_logX_b && !l_logY_b)) {
+    return false;
+  }
+  if ((l_logX_b && !m_useAutoRangeX_b && !((m_userdefinedMinX_d > 0) && (m_userdefinedMaxX_d > 0))) ||
+      (l_logY_b && !m_useAutoRangeY_b && !((m_userdefinedMinY_d > 0) && (m_userdefinedMaxY_d > 0)))) {
+    throw CException("CTikz::createTikzFile(): range of log axis must be positive.");
+  }
+  
+  // log10 of columns, each column is transformed only once
+  std::vector<std::pair<gType_TIKZ_Column_p, gType_TIKZ_Column_p> > l_transformed_v;
+  auto l_log10_p = [&](const gType_TIKZ_Column_p& f_column_p) -> gType_TIKZ_Column_p {
+    if (!f_column_p) {
+      return f_column_p;
+    }
+    for (std::size_t l_k_i = 0; l_k_i < l_transformed_v.size(); ++l_k_i) {
+      if (l_transformed_v[l_k_i].first == f_column_p) {
+        return l_transformed_v[l_k_i].second;
+      }
+    }
+    const std::vector<double>& l_value_v = *f_column_p;
+    std::shared_ptr<std::vector<double> > l_log_p = std::make_shared<std::vector<double> >(l_value_v.size());
+    std::vector<double>& l_log_v = *l_log_p;
+    CParallel::for_vd(l_value_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+      for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+        l_log_v[l_k_i] = (l_value_v[l_k_i] > 0) ? std::log10(l_value_v[l_k_i]) : std::numeric_limits<double>::quiet_NaN();
+      }
+    });
+    l_transformed_v.push_back(std::make_pair(f_column_p, gType_TIKZ_Column_p(l_log_p)));
+    return l_transformed_v.back().second;
+  };
+  std::vector<gType_TIKZ_DataSet_st> l_dataSet_v(m_dataSet_v);
+  for (std::vector<gType_TIKZ_DataSet_st>::iterator l_dataSet_it = l_dataSet_v.begin(); l_dataSet_it != l_dataSet_v.end(); ++l_dataSet_it) {
+    if (l_logX_b) { // log10 of uniform grid is no uniform grid
+      l_dataSet_it->x_p = l_log10_p(g_getColumnX_p(*l_dataSet_it));
+    }
+    if (l_logY_b && !m_isSecondAxis_b(*l_dataSet_it)) { // second y axis is linear
+      if (l_dataSet_it->error_p) {
+        throw CException("CTikz::createTikzFile(): error bars cannot be combined with log preprocessing of y axis.");
+      }
+      // filters smooth values of user, i.e. they run before log10
+      l_dataSet_it->y_p = l_log10_p(g_getColumnY_p(*l_dataSet_it));
+      l_dataSet_it->filter_v.clear();
+      l_dataSet_it->lower_p = l_log10_p(l_dataSet_it->lower_p);
+      l_dataSet_it->upper_p = l_log10_p(l_dataSet_it->upper_p);
+    }
+    l_dataSet_it->cache_p.reset();
+  }
+  
+  // keep settings of user aside
+  f_settings_st.dataSet_v.swap(m_dataSet_v);
+  m_dataSet_v.swap(l_dataSet_v);
+  f_settings_st.sharedTable_v.swap(m_sharedTable_v);
+  f_settings_st.headerCache_s.swap(m_headerCache_s);
+  f_settings_st.settingsDirty_b = m_settingsDirty_b;
+  f_settings_st.headerCacheType_e = m_headerCacheType_e;
+  f_settings_st.logOnX_b = m_logOnX_b;
+  f_settings_st.logOnY_b = m_logOnY_b;
+  f_settings_st.userdefinedMinX_d = m_userdefinedMinX_d;
+  f_settings_st.userdefinedMaxX_d = m_userdefinedMaxX_d;
+  f_settings_st.userdefinedMinY_d = m_userdefinedMinY_d;
+  f_settings_st.userdefinedMaxY_d = m_userdefinedMaxY_d;
+  f_settings_st.additionalSettings_v = m_additionalSettings_v;
+  
+  // linear axes of log10 values
+  m_settingsDirty_b = true;
+  if (l_logX_b) {
+    m_logOnX_b = false;
+    m_userdefinedMinX_d = std::log10(m_userdefinedMinX_d);
+    m_userdefinedMaxX_d = std::log10(m_userdefinedMaxX_d);
+    m_additionalSettings_v.push_back(m_getLogTicks_s("x", m_getMinX_d(), m_getMaxX_d()));
+  }
+  if (l_logY_b) {
+    m_logOnY_b = false;
+    m_userdefinedMinY_d = std::log10(m_userdefinedMinY_d);
+    m_userdefinedMaxY_d = std::log10(m_userdefinedMaxY_d);
+    m_additionalSettings_v.push_back(m_getLogTicks_s("y", m_getMinY_d(), m_getMaxY_d()));
+  }
+  return true;
+}
+
+
+// ========================================================================
+// restore settings of user replaced by m_beginLogTransform_b
+// ========================================================================
+void CTikz::m_endLogTransform_vd(gType_TIKZ_LogSettings_st& f_settings_st)
+{
+  m_dataSet_v.swap(f_settings_st.dataSet_v);
+  m_sharedTable_v.swap(f_settings_st.sharedTable_v);
+  m_headerCache_s.swap(f_settings_st.headerCache_s);
+  m_settingsDirty_b = f_settings_st.settingsDirty_b;
+  m_headerCacheType_e = f_settings_st.headerCacheType_e;
+  m_logOnX_b = f_settings_st.logOnX_b;
+  m_logOnY_b = f_settings_st.logOnY_b;
+  m_userdefinedMinX_d = f_settings_st.userdefinedMinX_d;
+  m_userdefinedMaxX_d = f_settings_st.userdefinedMaxX_d;
+  m_userdefinedMinY_d = f_settings_st.userdefinedMinY_d;
+  m_userdefinedMaxY_d = f_settings_st.userdefinedMaxY_d;
+  m_additionalSettings_v.swap(f_settings_st.additionalSettings_v);
+}
+
+
+// ========================================================================
+// get ticks of linear axis of log10 values. Ticks at powers of ten (at most
+// about eight labels, minor ticks at multiples within decades), within less
+// than one decade at multiples of power of ten.
+// ========================================================================
+std::string CTikz::m_getLogTicks_s(const std::string& f_axis_s, double f_min_d, double f_max_d)
+{
+  std::stringstream l_ticks_ss;
+  std::stringstream l_labels_ss;
+  std::stringstream l_minor_ss;
+  const double l_eps_d = 1e-9;
+  const int l_first_i = static_cast<int>(std::ceil(f_min_d - l_eps_d));
+  const int l_last_i = static_cast<int>(std::floor(f_max_d + l_eps_d));
+  if (l_last_i > l_first_i) { // powers of ten
+    const int l_step_i = std::max(1, (l_last_i - l_first_i + 7) / 8);
+    for (int l_k_i = l_first_i; l_k_i <= l_last_i; l_k_i += l_step_i) {
+      l_ticks_ss << ((l_first_i == l_k_i) ? "" : ",") << l_k_i;
+      l_labels_ss << ((l_first_i == l_k_i) ? "" : ",") << "{$10^{" << l_k_i << "}$}";
+    }
+    for (int l_k_i = l_first_i - 1; (1 == l_step_i) && (l_k_i <= l_last_i); ++l_k_i) {
+      for (int l_m_i = 2; l_m_i <= 9; ++l_m_i) {
+        const double l_tick_d = l_k_i + std::log10(static_cast<double>(l_m_i));
+        if ((l_tick_d >= f_min_d) && (l_tick_d <= f_max_d)) {
+          l_minor_ss << (l_minor_ss.str().empty() ? "" : ",") << l_tick_d;
+        }
+      }
+    }
+  } else { // multiples of power of ten
+    bool l_firstTick_b = true;
+    for (int l_k_i = static_cast<int>(std::floor(f_min_d)); l_k_i <= static_cast<int>(std::ceil(f_max_d)); ++l_k_i) {
+      for (int l_m_i = 1; l_m_i <= 9; ++l_m_i) {
+        const double l_tick_d = l_k_i + std::log10(static_cast<double>(l_m_i));
+        if ((l_tick_d >= f_min_d - l_eps_d) && (l_tick_d <= f_max_d + l_eps_d)) {
+          l_ticks_ss << (l_firstTick_b ? "" : ",") << l_tick_d;
+          l_labels_ss << (l_firstTick_b ? "" : ",") << "{$";
+          if (1 != l_m_i) {
+            l_labels_ss << l_m_i << "\\cdot ";
+          }
+          l_labels_ss << "10^{" << l_k_i << "}$}";
+          l_firstTick_b = false;
+        }
+      }
+    }
+  }
+  std::string l_options_s = f_axis_s + "tick={" + l_ticks_ss.str() + "},\n";
+  l_options_s += f_axis_s + "ticklabels={" + l_labels_ss.str() + "}";
+  if (!l_minor_ss.str().empty()) {
+    l_options_s += ",\nminor " + f_axis_s + "tick={" + l_minor_ss.str() + "}";
+  }
+  return l_options_s;
+}
+
+
+// ========================================================================
+// get ticks of time axis. Step is taken out of steps of clock and calendar
+// (at most about eight labels), ticks are multiples of step in UTC.
+// Timestamps are split into whole seconds and fraction, i.e. ticks and
+// labels are exact also for large timestamps. Date is written in front
+// of time at first tick and when date changes.
+// ========================================================================
+std::string CTikz::m_getTimeTicks_s(double f_min_d, double f_max_d)
+{
+  if (!(f_max_d > f_min_d) || !std::isfinite(f_max_d - f_min_d)) {
+    return "";
+  }
+  // epoch as whole seconds and fraction of second
+  const int64_t l_unitsPerSecond_i = g_getUnitsPerSecond_i(m_timeUnit_e);
+  const int64_t l_epochSec_i = g_floorDiv_i(m_timeEpoch_i, l_unitsPerSecond_i);
+  const double l_epochFrac_d = static_cast<double>(m_timeEpoch_i - l_epochSec_i * l_unitsPerSecond_i) / l_unitsPerSecond_i;
+  
+  // steps of clock (1, 2, 5 below one second) and calendar (1, 2, 5 above two weeks)
+  std::vector<double> l_steps_v;
+  for (int l_exp_i = -9; l_exp_i < 0; ++l_exp_i) {
+    l_steps_v.push_back(1 * std::pow(10.0, l_exp_i));
+    l_steps_v.push_back(2 * std::pow(10.0, l_exp_i));
+    l_steps_v.push_back(5 * std::pow(10.0, l_exp_i));
+  }
+  const double l_clock_pd[] = {1, 2, 5, 10, 15, 30, 60, 120, 300, 600, 900, 1800, 3600, 7200, 10800, 21600, 43200,
+                               86400, 2 * 86400, 7 * 86400, 14 * 86400};
+  l_steps_v.insert(l_steps_v.end(), l_clock_pd, l_clock_pd + sizeof(l_clock_pd) / sizeof(l_clock_pd[0]));
+  for (double l_days_d = 20; l_days_d < 1e8; l_days_d *= 10) {
+    l_steps_v.push_back(l_days_d * 86400);
+    l_steps_v.push_back(2.5 * l_days_d * 86400);
+    l_steps_v.push_back(5 * l_days_d * 86400);
+  }
+  const double l_range_d = f_max_d - f_min_d;
+  std::size_t l_stepIdx_i = 0;
+  while ((l_stepIdx_i + 1 < l_steps_v.size()) && (l_range_d / l_steps_v[l_stepIdx_i] > 8)) {
+    ++l_stepIdx_i;
+  }
+  const double l_step_d = l_steps_v[l_stepIdx_i];
+  
+  // first tick: minimum of axis as whole seconds and fraction
+  const double l_eps_d = 1e-9 * l_step_d;
+  const double l_minAbs_d = l_epochFrac_d + f_min_d;
+  const int64_t l_minSec_i = l_epochSec_i + static_cast<int64_t>(std::floor(l_minAbs_d));
+  const double l_minFrac_d = l_minAbs_d - std::floor(l_minAbs_d);
+  int64_t l_tickSec_i = l_minSec_i;
+  double l_tickFrac_d = 0;
+  int64_t l_stepSec_i = 0;
+  if (l_step_d >= 1) {
+    l_stepSec_i = static_cast<int64_t>(l_step_d);
+    const int64_t l_startSec_i = l_minSec_i + ((l_minFrac_d > l_eps_d) ? 1 : 0);
+    l_tickSec_i = -g_floorDiv_i(-l_startSec_i, l_stepSec_i) * l_stepSec_i;
+  } else {
+    l_tickFrac_d = std::ceil((l_minFrac_d - l_eps_d) / l_step_d) * l_step_d;
+  }
+  const int l_decimals_i = (l_step_d < 1) ? static_cast<int>(std::ceil(-std::log10(l_step_d) - 1e-9)) : 0;
+  const int64_t l_fracScale_i = static_cast<int64_t>(std::pow(10.0, l_decimals_i) + 0.5);
+  const char* l_format_pc = (l_step_d >= 86400) ? "%Y-%m-%d" : ((0 == l_stepSec_i % 60) && (l_stepSec_i > 0)) ? "%H:%M" : "%H:%M:%S";
+  
+  std::string l_ticks_s;
+  std::string l_labels_s;
+  std::string l_lastDate_s;
+  for (int l_k_i = 0; l_k_i < 100; ++l_k_i) {
+    const double l_offset_d = static_cast<double>(l_tickSec_i - l_epochSec_i) - l_epochFrac_d + l_tickFrac_d;
+    if (l_offset_d > f_max_d + l_eps_d) {
+      break;
+    }
+    // fraction of label rounded to decimals of step
+    int64_t l_labelSec_i = l_tickSec_i + static_cast<int64_t>(std::floor(l_tickFrac_d));
+    int64_t l_labelFrac_i = static_cast<int64_t>(std::floor((l_tickFrac_d - std::floor(l_tickFrac_d)) * l_fracScale_i + 0.5));
+    if (l_labelFrac_i >= l_fracScale_i) {
+      ++l_labelSec_i;
+      l_labelFrac_i -= l_fracScale_i;
+    }
+    const time_t l_time_i = static_cast<time_t>(l_labelSec_i);
+    struct tm l_time_st;
+    gmtime_r(&l_time_i, &l_time_st);
+    char l_buffer_pc[64];
+    std::strftime(l_buffer_pc, sizeof(l_buffer_pc), "%Y-%m-%d", &l_time_st);
+    const std::string l_date_s = l_buffer_pc;
+    std::strftime(l_buffer_pc, sizeof(l_buffer_pc), l_format_pc, &l_time_st);
+    std::string l_label_s = l_buffer_pc;
+    if (l_decimals_i > 0) {
+      std::snprintf(l_buffer_pc, sizeof(l_buffer_pc), ".%0*lld", l_decimals_i, static_cast<long long>(l_labelFrac_i));
+      l_label_s += l_buffer_pc;
+    }
+    if ((l_step_d < 86400) && (l_date_s != l_lastDate_s)) {
+      l_label_s = l_date_s + "\\\\" + l_label_s;
+    }
+    l_lastDate_s = l_date_s;
+    l_ticks_s += (l_ticks_s.empty() ? "" : ",") + g_formatExact_s(l_offset_d);
+    l_labels_s += (l_labels_s.empty() ? "{" : ",{") + l_label_s + "}";
+    if (l_step_d >= 1) {
+      l_tickSec_i += l_stepSec_i;
+    } else {
+      l_tickFrac_d += l_step_d;
+    }
+  }
+  if (l_ticks_s.empty()) {
+    return "";
+  }
+  std::string l_options_s = "xtick={" + l_ticks_s + "},\n";
+  l_options_s += "xticklabels={" + l_labels_s + "},\n";
+  l_options_s += "xticklabel style={align=center}";
+  return l_options_s;
+}
+
+
+// ========================================================================
+// cut data set entries to window of x axis. Pyramid is built at first use
+// and kept in data set entry of user (also when data is not sorted, i.e.
+// data is checked only once); log10 of coordinates is a new column each
+// time, its pyramid is built for this file only.
+// ========================================================================
+bool CTikz::m_applyWindow_b(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                            std::vector<gType_TIKZ_DataSet_st>& f_dataSetWindow_v)
+{
+  if (!m_pyramid_b || (e_TIKZ_PlotTypeLine != f_plotParam_st.type_e) || f_plotParam_st.groupPanel_b || m_logOnX_b) {
+    return false;
+  }
+  const double l_dpi_d = (m_pyramidDpi_d > 0) ? m_pyramidDpi_d : m_rasterResolution_d;
+  const std::size_t l_buckets_i = static_cast<std::size_t>(std::ceil(m_getLengthInch_d(m_width_s) * l_dpi_d));
+  const double l_minX_d = m_getMinX_d();
+  const double l_maxX_d = m_getMaxX_d();
+  bool l_window_b = false;
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v[l_k_i];
+    if (l_dataSet_st.raster_b || l_dataSet_st.lower_p || l_dataSet_st.error_p || g_hasMarks_b(l_dataSet_st.plotStyle_s) ||
+        (l_dataSet_st.y_p->size() <= 2 * l_buckets_i + 2)) {
+      continue;
+    }
+    // x column of uniform grid and filtered y column are kept by pyramid only (pyramid is
+    // reset when filters change)
+    const bool l_uniformX_b = !l_dataSet_st.x_p;
+    const bool l_filterY_b = !l_dataSet_st.filter_v.empty();
+    if (!l_dataSet_st.pyramid_p ||
+        !l_dataSet_st.pyramid_p->refersTo_b(l_uniformX_b ? l_dataSet_st.pyramid_p->getDataX_p() : l_dataSet_st.x_p,
+                                            l_filterY_b ? l_dataSet_st.pyramid_p->getDataY_p() : l_dataSet_st.y_p)) {
+      l_dataSet_st.pyramid_p = std::make_shared<const CPyramid>(g_getColumnX_p(l_dataSet_st), g_getColumnY_p(l_dataSet_st));
+    }
+    if (!l_dataSet_st.pyramid_p->valid_b()) {
+      continue;
+    }
+    if (!l_window_b) {
+      f_dataSetWindow_v = m_dataSet_v;
+      l_window_b = true;
+    }
+    std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >();
+    std::shared_ptr<std::vector<double> > l_dataY_p = std::make_shared<std::vector<double> >();
+    l_dataSet_st.pyramid_p->query_vd(l_minX_d, l_maxX_d, l_buckets_i, *l_dataX_p, *l_dataY_p);
+    gType_TIKZ_DataSet_st& l_window_st = f_dataSetWindow_v[l_k_i];
+    l_window_st.x_p = l_dataX_p;
+    l_window_st.y_p = l_dataY_p;
+    l_window_st.filter_v.clear();
+    l_window_st.pyramid_p.reset();
+    l_window_st.cache_p.reset();
+  }
+  return l_window_b;
+}
+
+
+// ========================================================================
+// check graphics against budget. Line plots are reduced in three steps:
+// data set entries which cannot be decimated (marks, unsorted x values)
+// are rasterized, largest first, until decimated data set entries would
+// fit in. Then data set entries with sorted x values and without marks are
+// decimated (minimum and maximum per bucket, at least one bucket per pt of
+// axis width). Finally remaining largest data set entries are rasterized.
+// ========================================================================
+bool CTikz::m_applyBudget_b(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                            std::vector<gType_TIKZ_DataSet_st>& f_dataSetReduced_v)
+{
+  if (e_TIKZ_BudgetOff == m_budget_e) {
+    return false;
+  }
+  const double l_cost_d = m_estimateCost_d(f_plotParam_st, m_dataSet_v);
+  if (l_cost_d <= m_budgetMaxCost_d) {
+    return false;
+  }
+  if ((e_TIKZ_BudgetReduce == m_budget_e) && (e_TIKZ_PlotTypeLine == f_plotParam_st.type_e)) {
+    f_dataSetReduced_v = m_dataSet_v;
+    const std::size_t l_minBuckets_i = static_cast<std::size_t>(std::ceil(m_getLengthInch_d(m_width_s) * 72.27));
+    std::vector<bool> l_decimate_v(f_dataSetReduced_v.size(), false);
+    double l_costDecimate_d = 0; // cost of coordinates of data set entries to decimate
+    double l_costDecimateMin_d = 0; // same after maximum decimation
+    for (std::size_t l_k_i = 0; l_k_i < f_dataSetReduced_v.size(); ++l_k_i) {
+      const gType_TIKZ_DataSet_st& l_dataSet_st = f_dataSetReduced_v[l_k_i];
+      l_decimate_v[l_k_i] = !l_dataSet_st.raster_b && !l_dataSet_st.lower_p && !l_dataSet_st.error_p && !g_hasMarks_b(l_dataSet_st.plotStyle_s) &&
+                            (l_dataSet_st.y_p->size() > 2 * l_minBuckets_i + 2) &&
+                            (l_dataSet_st.x_p ? std::is_sorted(l_dataSet_st.x_p->begin(), l_dataSet_st.x_p->end()) : (l_dataSet_st.stepX_d > 0));
+      if (l_decimate_v[l_k_i]) {
+        l_costDecimate_d += static_cast<double>(l_dataSet_st.y_p->size());
+        l_costDecimateMin_d += static_cast<double>(2 * l_minBuckets_i + 2);
+      }
+    }
+    
+    // rasterization of largest data set entries, first data set entries which cannot be decimated
+    bool l_rasterAll_b = false;
+    double l_costReduced_d = l_cost_d;
+    while (true) {
+      const double l_costRemaining_d = l_rasterAll_b ? l_costReduced_d : l_costReduced_d - l_costDecimate_d + l_costDecimateMin_d;
+      if (l_costRemaining_d <= m_budgetMaxCost_d) {
+        break;
+      }
+      std::size_t l_largest_i = f_dataSetReduced_v.size();
+      for (std::size_t l_k_i = 0; l_k_i < f_dataSetReduced_v.size(); ++l_k_i) {
+        const gType_TIKZ_DataSet_st& l_dataSet_st = f_dataSetReduced_v[l_k_i];
+        if (!l_dataSet_st.raster_b && (l_rasterAll_b || !l_decimate_v[l_k_i]) &&
+            ((f_dataSetReduced_v.size() == l_largest_i) || (l_dataSet_st.y_p->size() > f_dataSetReduced_v[l_largest_i].y_p->size()))) {
+          l_largest_i = l_k_i;
+        }
+      }
+      if (f_dataSetReduced_v.size() != l_largest_i) {
+        f_dataSetReduced_v[l_largest_i].raster_b = true;
+        f_dataSetReduced_v[l_largest_i].cache_p.reset();
+        l_costReduced_d = m_estimateCost_d(f_plotParam_st, f_dataSetReduced_v);
+      } else if (!l_rasterAll_b) { // decimation is not sufficient
+        l_rasterAll_b = true;
+        l_costReduced_d = m_estimateCost_d(f_plotParam_st, f_dataSetReduced_v);
+      } else { // nothing left to rasterize
+        break;
+      }
+    }
+    
+    // decimation: points of decimated data set entries are scaled down by same factor
+    l_costDecimate_d = 0;
+    for (std::size_t l_k_i = 0; l_k_i < f_dataSetReduced_v.size(); ++l_k_i) {
+      l_decimate_v[l_k_i] = l_decimate_v[l_k_i] && !f_dataSetReduced_v[l_k_i].raster_b;
+      if (l_decimate_v[l_k_i]) {
+        l_costDecimate_d += static_cast<double>(f_dataSetReduced_v[l_k_i].y_p->size());
+      }
+    }
+    if ((l_costReduced_d > m_budgetMaxCost_d) && (l_costDecimate_d > 0)) {
+      const double l_scale_d = std::max(0.0, m_budgetMaxCost_d - (l_costReduced_d - l_costDecimate_d)) / l_costDecimate_d;
+      for (std::size_t l_k_i = 0; l_k_i < f_dataSetReduced_v.size(); ++l_k_i) {
+        gType_TIKZ_DataSet_st& l_dataSet_st = f_dataSetReduced_v[l_k_i];
+        if (!l_decimate_v[l_k_i]) {
+          continue;
+        }
+        const std::size_t l_buckets_i = std::max(l_minBuckets_i, static_cast<std::size_t>(std::max(0.0, l_dataSet_st.y_p->size() * l_scale_d / 2 - 1)));
+        if (2 * l_buckets_i + 2 >= l_dataSet_st.y_p->size()) {
+          continue;
+        }
+        std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >();
+        std::shared_ptr<std::vector<double> > l_dataY_p = std::make_shared<std::vector<double> >();
+        // filters run in same pass as decimation, decimated values are filtered values
+        CFilter l_filter_c(*l_dataSet_st.y_p);
+        g_addFilters_vd(l_filter_c, l_dataSet_st.filter_v);
+        g_decimateMinMax_vd(*g_getColumnX_p(l_dataSet_st), l_filter_c, l_buckets_i, *l_dataX_p, *l_dataY_p);
+        l_dataSet_st.x_p = l_dataX_p;
+        l_dataSet_st.y_p = l_dataY_p;
+        l_dataSet_st.filter_v.clear();
+        l_dataSet_st.cache_p.reset();
+      }
+      l_costReduced_d = m_estimateCost_d(f_plotParam_st, f_dataSetReduced_v);
+    }
+    if (l_costReduced_d <= m_budgetMaxCost_d) {
+      return true;
+    }
+  }
+  
+  std::size_t l_numData_i = 0;
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = m_dataSet_v.begin(); l_dataSet_it != m_dataSet_v.end(); ++l_dataSet_it) {
+    l_numData_i += l_dataSet_it->y_p->size();
+  }
+  std::stringstream l_msg_ss;
+  l_msg_ss << "CTikz: estimated TeX cost " << l_cost_d << " of graphics (" << l_numData_i << " values in ";
+  l_msg_ss << m_dataSet_v.size() << " data set entries) exceeds budget " << m_budgetMaxCost_d << ".";
+  throw CException(l_msg_ss.str());
+}
+
+
+// ========================================================================
+// get axis header (file comment, begin of picture and axis options).
+// Header is only recreated when settings or data changed.
+// ========================================================================
+const std::string& CTikz::m_getHeader_s(gType_TIKZ_PlotType_e f_plotType_e)
+{
+  if (!m_settingsDirty_b && (f_plotType_e == m_headerCacheType_e)) {
+    return m_headerCache_s;
+  }
+  std::stringstream l_tikz_ss;
+  l_tikz_ss << "% file automatically generated by CTikz" << std::endl;
+  l_tikz_ss << "% author: " << m_author_s << std::endl;
+  l_tikz_ss << "% " << std::endl;
+  l_tikz_ss << "% info: " << m_info_s << std::endl;
+  l_tikz_ss << "% " << std::endl;
+  l_tikz_ss << "\\begin{tikzpicture}" << std::endl;
+  for (std::vector<std::string>::iterator l_cmd_it = m_additionalsCommandsAfterBeginTikzPicture_v.begin(); l_cmd_it != m_additionalsCommandsAfterBeginTikzPicture_v.end(); ++l_cmd_it) {
+    l_tikz_ss << *l_cmd_it << std::endl;
+  }
+  l_tikz_ss << "\\begin{axis}[" << std::endl;
+  const bool l_rangeX_b = true;
+  const bool l_rangeY_b = true;
+  m_writeAxisOptions_vd(l_tikz_ss, f_plotType_e, l_rangeX_b, l_rangeY_b);
+  l_tikz_ss << "]" << std::endl;
+  if ("" != m_legendTitle_s) {
+    l_tikz_ss << "\\addlegendimage{empty legend}" << std::endl;
+  }
+  m_headerCache_s = l_tikz_ss.str();
+  m_headerCacheType_e = f_plotType_e;
+  m_settingsDirty_b = false;
+  return m_headerCache_s;
+}
+
+
+// ========================================================================
+// get header of panel in group plot: options of axis without ranges
+// shared by group, legend title. Header is not cached.
+// ========================================================================
+std::string CTikz::m_getPanelHeader_s(const gType_TIKZ_PlotParam_st& f_plotParam_st)
+{
+  std::stringstream l_tikz_ss;
+  l_tikz_ss << "\\nextgroupplot[" << std::endl;
+  m_writeAxisOptions_vd(l_tikz_ss, f_plotParam_st.type_e, !f_plotParam_st.sharedX_b, !f_plotParam_st.sharedY_b);
+  l_tikz_ss << "]" << std::endl;
+  if ("" != m_legendTitle_s) {
+    l_tikz_ss << "\\addlegendimage{empty legend}" << std::endl;
+  }
+  return l_tikz_ss.str();
+}
+
+
+// ========================================================================
+// write options of axis (size, ranges, labels, grid, title, additional
+// settings, legend style), ranges are omitted when set outside of axis
+// ========================================================================
+void CTikz::m_writeAxisOptions_vd(std::stringstream& f_tikz_ss,
+                                  gType_TIKZ_PlotType_e f_plotType_e,
+                                  bool f_rangeX_b,
+                                  bool f_rangeY_b)
+{
+  const bool l_createHist_b = (e_TIKZ_PlotTypeHist == f_plotType_e);
+  f_tikz_ss << ">=latex," << std::endl;
+  f_tikz_ss << "width=" << m_width_s << "," << std::endl;
+  f_tikz_ss << "height=" << m_height_s << "," << std::endl;
+  f_tikz_ss << "scale only axis," << std::endl;
+  if (e_TIKZ_PlotTypeBox == f_plotType_e) { // one box per data set entry at x = 1, 2, ...
+    f_tikz_ss << "xmin=0.5," << std::endl;
+    f_tikz_ss << "xmax=" << m_dataSet_v.size() + 0.5 << "," << std::endl;
+    f_tikz_ss << "xtick={";
+    for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+      f_tikz_ss << ((0 == l_k_i) ? "" : ",") << l_k_i + 1;
+    }
+    f_tikz_ss << "}," << std::endl;
+    if (!m_legend_v.empty()) {
+      f_tikz_ss << "xticklabels={";
+      for (std::size_t l_k_i = 0; (l_k_i < m_dataSet_v.size()) && (l_k_i < m_legend_v.size()); ++l_k_i) {
+        f_tikz_ss << ((0 == l_k_i) ? "" : ",") << "{" << m_legend_v.at(l_k_i) << "}";
+      }
+      f_tikz_ss << "}," << std::endl;
+    }
+  } else if (f_rangeX_b) {
+    f_tikz_ss << "xmin=" << m_getMinX_d() << "," << std::endl;
+    f_tikz_ss << "xmax=" << m_getMaxX_d() << "," << std::endl;
+    if (m_timeAxis_b && !m_logOnX_b && !l_createHist_b) { // x values of histogram are y values
+      const std::string l_ticks_s = m_getTimeTicks_s(m_getMinX_d(), m_getMaxX_d());
+      if (!l_ticks_s.empty()) {
+        f_tikz_ss << l_ticks_s << "," << std::endl;
+      }
+    }
+  }
+  f_tikz_ss << "xlabel={" << m_xLabel_s << "}," << std::endl;
+  if (m_gridOnX_b) {
+    f_tikz_ss << "xmajorgrids," << std::endl;
+  }
+  if (m_logOnX_b && (e_TIKZ_PlotTypeBox != f_plotType_e)) {
+    f_tikz_ss << "xmode=log,log basis x=10," << std::endl;
+  }
+  if (!l_createHist_b && f_rangeY_b) { // normal mode
+    f_tikz_ss << "ymin=" << m_getMinY_d() << "," << std::endl;
+    f_tikz_ss << "ymax=" << m_getMaxY_d() << "," << std::endl;
+  }
+  f_tikz_ss << "ylabel={" << m_yLabel_s << "}," << std::endl;
+  if (l_createHist_b) { // histogram mode
+    f_tikz_ss << "ymin=0," << std::endl;
+    f_tikz_ss << "ybar," << std::endl;
+  }
+  if (e_TIKZ_PlotTypeHist2d == f_plotType_e) { // 2D histogram: bins fill complete axis
+    f_tikz_ss << "enlargelimits=false," << std::endl;
+    f_tikz_ss << "axis on top," << std::endl;
+    f_tikz_ss << "colorbar," << std::endl;
+    f_tikz_ss << "colormap={ctikz}{";
+    for (int l_k_i = 0; l_k_i < g_colormapSize_i; ++l_k_i) {
+      f_tikz_ss << ((0 == l_k_i) ? "" : " ") << "rgb255=(" << int(g_colormap_ppi[l_k_i][0]) << ",";
+      f_tikz_ss << int(g_colormap_ppi[l_k_i][1]) << "," << int(g_colormap_ppi[l_k_i][2]) << ")";
+    }
+    f_tikz_ss << "}," << std::endl;
+    f_tikz_ss << "point meta min=0," << std::endl;
+  }
+  if (m_gridOnY_b) {
+    f_tikz_ss << "ymajorgrids," << std::endl;
+  }
+  if (m_logOnY_b) {
+    f_tikz_ss << "ymode=log,log basis y=10," << std::endl;
+  }
+  f_tikz_ss << "title={" << m_title_s << "}," << std::endl;
+  for (std::vector<std::string>::const_iterator l_settings_it = m_additionalSettings_v.begin();
+       l_settings_it != m_additionalSettings_v.end(); ++l_settings_it) {
+    f_tikz_ss << *l_settings_it << "," << std::endl;
+  }
+  f_tikz_ss << "legend style={" << m_legendStyle_s << "}" << std::endl;
+}
+
+
+// ========================================================================
+// write addplot code of all data set entries. Tables are taken from cache.
+// Second y axis of same object: plots of both axes are split into first
+// and second axis, legend is part of second axis (on top of all plots).
+// ========================================================================
+void CTikz::m_writePlots_vd(std::string& f_code_s,
+                            const std::string& f_filename_s,
+                            const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                            bool f_secondAxis_b)
+{
+  const bool l_createHist_b = (e_TIKZ_PlotTypeHist == f_plotParam_st.type_e);
+  const bool l_otherObject_b = f_secondAxis_b && !m_splitAxes_b; // code for second axis of other object
+  const bool l_legend_b = !m_splitAxes_b || f_secondAxis_b;
+  bool l_legendTitleSet_b = l_otherObject_b; // legend title is not used for second axis of other object
+  std::size_t l_legendIdx_i = l_otherObject_b ? m_dataSet_v.size() : 0;
+  int l_IdCtr_i = 0;
+  std::vector<gType_TIKZ_Column_p> l_sharedX_v; // common x columns whose table is written
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    const gType_TIKZ_DataSet_st& l_dataSetEntry_st = m_dataSet_v[l_k_i];
+    const bool l_raster_b = l_dataSetEntry_st.raster_b && !l_createHist_b;
+    const bool l_otherAxis_b = m_splitAxes_b && (l_dataSetEntry_st.secondAxis_b != f_secondAxis_b);
+    if (l_dataSetEntry_st.lower_p && !l_createHist_b && !l_otherAxis_b) { // band of envelope below center line
+      m_writeEnvelopeBand_vd(f_code_s, l_k_i);
+    }
+    std::stringstream l_plot_ss;
+    if (l_otherAxis_b) { // plot of other y axis, only its legend image is part of second axis
+      if (f_secondAxis_b) {
+        f_code_s += "\\addlegendimage{color=" + l_dataSetEntry_st.color_s + "," + l_dataSetEntry_st.plotStyle_s + "}\n";
+      }
+    } else if (l_raster_b) { // raster graphics, legend image stays vector graphics
+      std::string l_filenameBase_s;
+      std::string l_extension_s;
+      m_splitFilename_vd(f_filename_s, l_filenameBase_s, l_extension_s);
+      std::stringstream l_filenameRaster_ss;
+      l_filenameRaster_ss << l_filenameBase_s << "_raster" << l_k_i << ".png";
+      m_writeRaster_vd(l_k_i, l_filenameRaster_ss.str());
+      if ("" != l_dataSetEntry_st.comment_s) {
+        l_plot_ss << "% " << l_dataSetEntry_st.comment_s << std::endl;
+      }
+      const bool l_secondAxisY_b = m_isSecondAxis_b(l_dataSetEntry_st);
+      l_plot_ss << "\\addplot graphics [xmin=" << m_getMinX_d() << ",xmax=" << m_getMaxX_d();
+      l_plot_ss << ",ymin=" << (l_secondAxisY_b ? m_getMinY2_d() : m_getMinY_d());
+      l_plot_ss << ",ymax=" << (l_secondAxisY_b ? m_getMaxY2_d() : m_getMaxY_d()) << "]";
+      l_plot_ss << " {" << m_trimFilename_s(l_filenameRaster_ss.str()) << "};" << std::endl;
+      l_plot_ss << "\\addlegendimage{color=" << l_dataSetEntry_st.color_s << "," << l_dataSetEntry_st.plotStyle_s << "}" << std::endl;
+      f_code_s += l_plot_ss.str();
+    } else if (!l_createHist_b && (m_chunkSize_i > 0) && (l_dataSetEntry_st.y_p->size() > m_chunkSize_i) && !l_dataSetEntry_st.error_p) {
+      m_writeChunks_vd(f_code_s, l_k_i, l_otherObject_b);
+    } else if (!l_createHist_b && m_isSharedX_b(l_k_i)) {
+      m_writeSharedPlot_vd(f_code_s, l_k_i, l_sharedX_v, l_otherObject_b);
+    } else { // code is appended directly, i.e. without temporary streams
+      if (!l_createHist_b) { // normal mode
+        f_code_s += "\\addplot [color=" + l_dataSetEntry_st.color_s + ",";
+      } else { // histogram mode
+        f_code_s += "\\addplot+ [color=" + l_dataSetEntry_st.color_s + ",";
+        f_code_s += " ,hist={\n";
+        f_code_s += "    density,\n";
+        f_code_s += "    bins=" + std::to_string(f_plotParam_st.bins_i) + ",\n";
+        f_code_s += "    data min=" + g_toString_s(f_plotParam_st.dataMin_d) + ",\n";
+        f_code_s += "    data max=" + g_toString_s(f_plotParam_st.dataMax_d) + "\n";
+        f_code_s += " },";
+      }
+      std::shared_ptr<const gType_TIKZ_DataSetCache_st> l_cache_p;
+      if (l_dataSetEntry_st.raster_b) { // histogram of raster data set entry, table is not cached
+        gType_TIKZ_DataSet_st l_vectorEntry_st = l_dataSetEntry_st;
+        l_vectorEntry_st.raster_b = false;
+        const bool l_createTable_b = true;
+        l_cache_p = m_createCache_p(l_vectorEntry_st, l_createTable_b);
+      } else {
+        m_getCache_st(l_k_i);
+        l_cache_p = l_dataSetEntry_st.cache_p;
+      }
+      f_code_s += l_dataSetEntry_st.plotStyle_s;
+      f_code_s += (l_cache_p->gaps_i > 0) ? ",unbounded coords=jump" : "";
+      const bool l_errorBars_b = l_dataSetEntry_st.error_p && !l_createHist_b;
+      f_code_s += l_errorBars_b ? ",error bars/.cd,y dir=both,y explicit]\n" : "]\n";
+      if (("" != l_dataSetEntry_st.comment_s) && !l_otherObject_b) {
+        f_code_s += "% " + l_dataSetEntry_st.comment_s + "\n";
+      }
+      f_code_s += "  table[" + g_getTableOptions_s(*l_cache_p, 0) + (l_errorBars_b ? ",y error index=2" : "") + "]{%\n";
+      f_code_s += l_cache_p->table_s;
+      f_code_s += "};\n";
+    }
+    
+    if (!l_otherObject_b) {
+      // label refers to style of last plot, not available for raster graphics
+      if (!l_raster_b && !l_otherAxis_b) {
+        f_code_s += "\\label{addPlotLabel_" + m_id_s + "_" + std::to_string(l_IdCtr_i) + "}\n";
+      }
+      ++l_IdCtr_i;
+    }
+    if (!l_legend_b) {
+      continue;
+    }
+    if ("" != m_legendTitle_s && !l_legendTitleSet_b) {
+      f_code_s += "\\addlegendentry{\\hspace{-.6cm}" + m_legendTitle_s + "};\n";
+      l_legendTitleSet_b = true;
+    }
+    if (l_legendIdx_i < m_legend_v.size()) {
+      f_code_s += "\\addlegendentry{" + m_legend_v.at(l_legendIdx_i) + "};\n";
+      ++l_legendIdx_i;
+    }
+  }
+}
+
+
+// ========================================================================
+// write second y axis of same object on top of first axis: same size and
+// range of x axis, y axis at right side. Legend of both axes is written
+// with plots of second axis.
+// ========================================================================
+void CTikz::m_writeSecondAxis_vd(std::string& f_code_s,
+                                 const std::string& f_filename_s,
+                                 const gType_TIKZ_PlotParam_st& f_plotParam_st)
+{
+  std::stringstream l_code_ss;
+  l_code_ss << "\\begin{axis}[" << std::endl;
+  l_code_ss << "yticklabel pos=right," << std::endl;
+  l_code_ss << "xtick=\\empty," << std::endl;
+  l_code_ss << "axis y line=right," << std::endl;
+  l_code_ss << "y axis line style=-," << std::endl;
+  l_code_ss << "width=" << m_width_s << "," << std::endl;
+  l_code_ss << "height=" << m_height_s << "," << std::endl;
+  l_code_ss << "scale only axis," << std::endl;
+  l_code_ss << "xmin=" << m_getMinX_d() << "," << std::endl;
+  l_code_ss << "xmax=" << m_getMaxX_d() << "," << std::endl;
+  if (m_logOnX_b) {
+    l_code_ss << "xmode=log,log basis x=10," << std::endl;
+  }
+  l_code_ss << "ymin=" << m_getMinY2_d() << "," << std::endl;
+  l_code_ss << "ymax=" << m_getMaxY2_d() << "," << std::endl;
+  l_code_ss << "ylabel={" << m_y2Label_s << "}," << std::endl;
+  l_code_ss << "legend style={" << m_legendStyle_s << "}" << std::endl;
+  l_code_ss << "]" << std::endl;
+  if ("" != m_legendTitle_s) {
+    l_code_ss << "\\addlegendimage{empty legend}" << std::endl;
+  }
+  f_code_s += l_code_ss.str();
+  const bool l_secondAxis_b = true;
+  m_writePlots_vd(f_code_s, f_filename_s, f_plotParam_st, l_secondAxis_b);
+  f_code_s += "\\end{axis}\n";
+}
+
+
+// ========================================================================
+// write table of data set entry split into chained addplot commands. Each
+// chunk starts with last row of previous chunk, all chunks except last one
+// are excluded from legend and cycle list.
+// ========================================================================
+void CTikz::m_writeChunks_vd(std::string& f_code_s, std::size_t f_idx_i, bool f_secondAxis_b)
+{
+  const gType_TIKZ_DataSet_st& l_dataSetEntry_st = m_dataSet_v.at(f_idx_i);
+  const gType_TIKZ_DataSetCache_st& l_cache_st = m_getCache_st(f_idx_i);
+  const std::string& l_table_s = l_cache_st.table_s;
+  
+  // begin of each row of cached table
+  std::vector<std::size_t> l_rowBegin_v;
+  l_rowBegin_v.reserve(l_dataSetEntry_st.y_p->size() + 1);
+  l_rowBegin_v.push_back(0);
+  for (std::string::size_type l_pos_i = l_table_s.find('\n'); std::string::npos != l_pos_i; l_pos_i = l_table_s.find('\n', l_pos_i + 1)) {
+    l_rowBegin_v.push_back(l_pos_i + 1);
+  }
+  const std::size_t l_numRows_i = l_rowBegin_v.size() - 1;
+  
+  for (std::size_t l_first_i = 0; l_first_i + 1 < l_numRows_i; l_first_i += m_chunkSize_i - 1) {
+    const std::size_t l_last_i = std::min(l_first_i + m_chunkSize_i, l_numRows_i);
+    const bool l_lastChunk_b = (l_numRows_i == l_last_i);
+    f_code_s += "\\addplot [color=" + l_dataSetEntry_st.color_s + "," + l_dataSetEntry_st.plotStyle_s;
+    f_code_s += (l_cache_st.gaps_i > 0) ? ",unbounded coords=jump" : "";
+    f_code_s += l_lastChunk_b ? "]\n" : ",forget plot]\n";
+    if ((0 == l_first_i) && ("" != l_dataSetEntry_st.comment_s) && !f_secondAxis_b) {
+      f_code_s += "% " + l_dataSetEntry_st.comment_s + "\n";
+    }
+    f_code_s += "  table[" + g_getTableOptions_s(l_cache_st, l_first_i) + "]{%\n";
+    f_code_s.append(l_table_s, l_rowBegin_v[l_first_i], l_rowBegin_v[l_last_i] - l_rowBegin_v[l_first_i]);
+    f_code_s += "};\n";
+    if (l_lastChunk_b) {
+      break;
+    }
+  }
+}
+
+
+
+// ========================================================================
+// write addplot of data set entry referencing its column of common table.
+// Table is read by pgfplotstableread into macro (name consists of letters
+// only) before first plot of common x column.
+// ========================================================================
+void CTikz::m_writeSharedPlot_vd(std::string& f_code_s,
+                                 std::size_t f_idx_i,
+                                 std::vector<gType_TIKZ_Column_p>& f_sharedX_v,
+                                 bool f_secondAxis_b)
+{
+  const gType_TIKZ_DataSet_st& l_dataSetEntry_st = m_dataSet_v.at(f_idx_i);
+  std::vector<std::size_t> l_idx_v; // data set entries of table in order of columns
+  std::size_t l_column_i = 0;
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    if ((m_dataSet_v[l_k_i].x_p == l_dataSetEntry_st.x_p) && g_isLineTable_b(m_dataSet_v[l_k_i], m_chunkSize_i) &&
+        (m_dataSet_v[l_k_i].secondAxis_b == l_dataSetEntry_st.secondAxis_b)) {
+      if (l_k_i == f_idx_i) {
+        l_column_i = l_idx_v.size() + 1;
+      }
+      l_idx_v.push_back(l_k_i);
+    }
+  }
+  std::size_t l_table_i = std::find(f_sharedX_v.begin(), f_sharedX_v.end(), l_dataSetEntry_st.x_p) - f_sharedX_v.begin();
+  std::string l_name_s;
+  for (std::size_t l_n_i = l_table_i + 1; l_n_i > 0; l_n_i = (l_n_i - 1) / 26) {
+    l_name_s.insert(l_name_s.begin(), static_cast<char>('A' + (l_n_i - 1) % 26));
+  }
+  l_name_s = "\\ctikzTable" + l_name_s;
+  if (f_sharedX_v.size() == l_table_i) {
+    f_sharedX_v.push_back(l_dataSetEntry_st.x_p);
+    f_code_s += "\\pgfplotstableread[row sep=crcr,header=false]{%\n";
+    f_code_s += m_getSharedTable_s(l_idx_v);
+    f_code_s += "}" + l_name_s + "\n";
+  }
+  
+  const gType_TIKZ_DataSetCache_st& l_cache_st = m_getBounds_st(f_idx_i);
+  f_code_s += "\\addplot [color=" + l_dataSetEntry_st.color_s + "," + l_dataSetEntry_st.plotStyle_s;
+  f_code_s += (l_cache_st.gaps_i > 0) ? ",unbounded coords=jump]\n" : "]\n";
+  if (("" != l_dataSetEntry_st.comment_s) && !f_secondAxis_b) {
+    f_code_s += "% " + l_dataSetEntry_st.comment_s + "\n";
+  }
+  if (l_cache_st.uniformX_b) { // table without x column
+    f_code_s += "  table[" + g_getUniformExpr_s(l_cache_st.startX_d, l_cache_st.stepX_d);
+    f_code_s += ",y index=" + std::to_string(l_column_i - 1) + "]{" + l_name_s + "};\n";
+  } else {
+    f_code_s += "  table[x index=0,y index=" + std::to_string(l_column_i) + "]{" + l_name_s + "};\n";
+  }
+}
+
+// ========================================================================
+// get program of TeX engine
+// ========================================================================
+std::string CTikz::m_getEngine_s()
+{
+  switch (m_engine_e) {
+    case e_TIKZ_EngineLualatex:
+      return "lualatex";
+    case e_TIKZ_EngineXelatex:
+      return "xelatex";
+    case e_TIKZ_EnginePdflatex:
+    default:
+      return "pdflatex";
+  }
+}
+
+
+// ========================================================================
+// get program and arguments of TeX engine. All engines write into directory
+// of latex file and stop at first error instead of asking for input.
+// ========================================================================
+std::vector<std::string> CTikz::m_getEngineArgs_v(const std::string& f_filenameTex_s, const std::string& f_path_s)
+{
+  std::vector<std::string> l_args_v;
+  l_args_v.push_back(m_getEngine_s());
+  l_args_v.push_back("-interaction=nonstopmode");
+  l_args_v.push_back("-halt-on-error");
+  l_args_v.push_back("--output-directory");
+  l_args_v.push_back(f_path_s);
+  l_args_v.push_back(f_filenameTex_s);
+  return l_args_v;
+}
+
+
+// ========================================================================
+// get first error message of TeX engine: line starting with "!" up to
+// line with line number ("l.<number>") of input where error occurred
+// ========================================================================
+std::string CTikz::m_getTexError_s(const std::string& f_filenameLog_s, const std::string& f_output_s)
+{
+  std::ifstream l_file_c(f_filenameLog_s.c_str());
+  std::stringstream l_log_ss;
+  if (l_file_c) {
+    l_log_ss << l_file_c.rdbuf();
+  } else {
+    l_log_ss << f_output_s;
+  }
+  std::string l_error_s;
+  std::string l_line_s;
+  while (std::getline(l_log_ss, l_line_s)) {
+    if (l_error_s.empty() && (0 != l_line_s.compare(0, 1, "!"))) {
+      continue;
+    }
+    l_error_s += l_line_s;
+    l_error_s += "\n";
+    if ((0 == l_line_s.compare(0, 2, "l.")) || (l_error_s.size() > 4096)) {
+      break;
+    }
+  }
+  return l_error_s;
+}
+
+
+// ========================================================================
+// write band of envelope: invisible lower and upper bound, area between
+// them is filled with color of data set entry
+// ========================================================================
+void CTikz::m_writeEnvelopeBand_vd(std::string& f_code_s, std::size_t f_idx_i)
+{
+  const gType_TIKZ_DataSet_st& l_dataSetEntry_st = m_dataSet_v.at(f_idx_i);
+  const gType_TIKZ_DataSetCache_st& l_cache_st = m_getCache_st(f_idx_i);
+  std::stringstream l_name_ss;
+  l_name_ss << "ctikzEnvelope_" << m_id_s << "_" << f_idx_i;
+  const std::string l_name_s = l_name_ss.str();
+  const std::string l_options_s = g_getTableOptions_s(l_cache_st, 0);
+  f_code_s += "\\addplot [name path=" + l_name_s + "_lower, draw=none, forget plot]\n";
+  f_code_s += "  table[" + l_options_s + "]{%\n";
+  f_code_s += l_cache_st.lowerTable_s;
+  f_code_s += "};\n";
+  f_code_s += "\\addplot [name path=" + l_name_s + "_upper, draw=none, forget plot]\n";
+  f_code_s += "  table[" + l_options_s + "]{%\n";
+  f_code_s += l_cache_st.upperTable_s;
+  f_code_s += "};\n";
+  f_code_s += "\\addplot [fill=" + l_dataSetEntry_st.color_s + ", fill opacity=0.25, draw=none, forget plot]\n";
+  f_code_s += "  fill between [of=" + l_name_s + "_upper and " + l_name_s + "_lower];\n";
+}
+
+
+// ========================================================================
+// write 2D histogram of all data set entries. Points are binned within axis
+// range (log scale: bins are equidistant in log space). Each thread counts
+// its chunk of points into its own bins, bins are summed up afterwards.
+// ========================================================================
+void CTikz::m_writeHist2d_vd(std::string& f_code_s,
+                             const std::string& f_filename_s,
+                             const gType_TIKZ_PlotParam_st& f_plotParam_st)
+{
+  const std::size_t l_binsX_i = static_cast<std::size_t>(f_plotParam_st.bins_i);
+  const std::size_t l_binsY_i = static_cast<std::size_t>(f_plotParam_st.binsY_i);
+  const double l_axisMinX_d = m_getMinX_d();
+  const double l_axisMaxX_d = m_getMaxX_d();
+  const double l_axisMinY_d = m_getMinY_d();
+  const double l_axisMaxY_d = m_getMaxY_d();
+  if ((m_logOnX_b && !(l_axisMinX_d > 0)) || (m_logOnY_b && !(l_axisMinY_d > 0))) {
+    throw CException("CTikz::writeHist2d(): range of log axis must be positive.");
+  }
+  const double l_minX_d = m_logOnX_b ? std::log10(l_axisMinX_d) : l_axisMinX_d;
+  const double l_maxX_d = m_logOnX_b ? std::log10(l_axisMaxX_d) : l_axisMaxX_d;
+  const double l_minY_d = m_logOnY_b ? std::log10(l_axisMinY_d) : l_axisMinY_d;
+  const double l_maxY_d = m_logOnY_b ? std::log10(l_axisMaxY_d) : l_axisMaxY_d;
+  const double l_scaleX_d = (l_maxX_d > l_minX_d) ? l_binsX_i / (l_maxX_d - l_minX_d) : 0;
+  const double l_scaleY_d = (l_maxY_d > l_minY_d) ? l_binsY_i / (l_maxY_d - l_minY_d) : 0;
+  
+  std::vector<uint64_t> l_count_v(l_binsX_i * l_binsY_i, 0);
+  uint64_t l_numPoints_i = 0;
+  for (std::vector<gType_TIKZ_DataSet_st>::const_iterator l_dataSet_it = m_dataSet_v.begin(); l_dataSet_it != m_dataSet_v.end(); ++l_dataSet_it) {
+    const gType_TIKZ_Column_p l_dataX_p = g_getColumnX_p(*l_dataSet_it);
+    const std::vector<double>& l_dataX_v = *l_dataX_p;
+    const gType_TIKZ_Column_p l_dataY_p = g_getColumnY_p(*l_dataSet_it);
+    const std::vector<double>& l_dataY_v = *l_dataY_p;
+    std::vector<std::vector<uint64_t> > l_threadCount_v(CParallel::numChunks_i(l_dataX_v.size()));
+    CParallel::for_vd(l_dataX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int f_thread_i) {
+      std::vector<uint64_t>& l_localCount_v = l_threadCount_v[f_thread_i];
+      l_localCount_v.assign(l_binsX_i * l_binsY_i, 0);
+      for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+        double l_x_d = l_dataX_v[l_k_i];
+        double l_y_d = l_dataY_v[l_k_i];
+        if ((m_logOnX_b && !(l_x_d > 0)) || (m_logOnY_b && !(l_y_d > 0))) {
+          continue;
+        }
+        l_x_d = ((m_logOnX_b ? std::log10(l_x_d) : l_x_d) - l_minX_d) * l_scaleX_d;
+        l_y_d = ((m_logOnY_b ? std::log10(l_y_d) : l_y_d) - l_minY_d) * l_scaleY_d;
+        // values at maximum of range belong to last bin, values outside of range and not finite values are ignored
+        if (!(l_x_d >= 0) || !(l_x_d <= l_binsX_i) || !(l_y_d >= 0) || !(l_y_d <= l_binsY_i)) {
+          continue;
+        }
+        const std::size_t l_binX_i = std::min(static_cast<std::size_t>(l_x_d), l_binsX_i - 1);
+        const std::size_t l_binY_i = std::min(static_cast<std::size_t>(l_y_d), l_binsY_i - 1);
+        ++l_localCount_v[l_binY_i * l_binsX_i + l_binX_i];
+      }
+    });
+    for (std::size_t l_t_i = 0; l_t_i < l_threadCount_v.size(); ++l_t_i) {
+      for (std::size_t l_b_i = 0; l_b_i < l_count_v.size(); ++l_b_i) {
+        l_count_v[l_b_i] += l_threadCount_v[l_t_i][l_b_i];
+      }
+    }
+    l_numPoints_i += l_dataX_v.size();
+  }
+  uint64_t l_maxCount_i = 0;
+  for (std::size_t l_b_i = 0; l_b_i < l_count_v.size(); ++l_b_i) {
+    l_maxCount_i = std::max(l_maxCount_i, l_count_v[l_b_i]);
+  }
+  
+  std::stringstream l_plot_ss;
+  l_plot_ss << "% 2D histogram of " << l_numPoints_i << " points, " << l_binsX_i << "x" << l_binsY_i << " bins" << std::endl;
+  if (f_plotParam_st.raster_b) { // one pixel per bin, empty bins are transparent
+    std::vector<unsigned char> l_rgba_v(l_count_v.size() * 4, 0);
+    for (std::size_t l_binY_i = 0; l_binY_i < l_binsY_i; ++l_binY_i) {
+      for (std::size_t l_binX_i = 0; l_binX_i < l_binsX_i; ++l_binX_i) {
+        const uint64_t l_count_i = l_count_v[l_binY_i * l_binsX_i + l_binX_i];
+        if (0 == l_count_i) {
+          continue;
+        }
+        // first image row is top of axis
+        unsigned char* l_pixel_p = &l_rgba_v[4 * ((l_binsY_i - 1 - l_binY_i) * l_binsX_i + l_binX_i)];
+        const double l_pos_d = static_cast<double>(l_count_i) / l_maxCount_i * (g_colormapSize_i - 1);
+        const int l_idx_i = std::min(static_cast<int>(l_pos_d), g_colormapSize_i - 2);
+        const double l_frac_d = l_pos_d - l_idx_i;
+        for (int l_c_i = 0; l_c_i < 3; ++l_c_i) {
+          l_pixel_p[l_c_i] = static_cast<unsigned char>(g_colormap_ppi[l_idx_i][l_c_i] * (1 - l_frac_d) + g_colormap_ppi[l_idx_i + 1][l_c_i] * l_frac_d + 0.5);
+        }
+        l_pixel_p[3] = 255;
+      }
+    }
+    std::string l_filenameBase_s;
+    std::string l_extension_s;
+    m_splitFilename_vd(f_filename_s, l_filenameBase_s, l_extension_s);
+    const std::string l_filenameRaster_s = l_filenameBase_s + "_hist2d.png";
+    CPng::write_vd(l_filenameRaster_s, static_cast<unsigned int>(l_binsX_i), static_cast<unsigned int>(l_binsY_i), l_rgba_v);
+    l_plot_ss << "\\addplot graphics [xmin=" << l_axisMinX_d << ",xmax=" << l_axisMaxX_d;
+    l_plot_ss << ",ymin=" << l_axisMinY_d << ",ymax=" << l_axisMaxY_d << "]";
+    l_plot_ss << " {" << m_trimFilename_s(l_filenameRaster_s) << "};" << std::endl;
+    // invisible plot sets range of colorbar
+    l_plot_ss << "\\addplot [draw=none, forget plot, point meta=explicit] coordinates {(";
+    l_plot_ss << l_axisMinX_d << "," << l_axisMinY_d << ") [0] (" << l_axisMaxX_d << "," << l_axisMaxY_d << ") [" << l_maxCount_i << "]};" << std::endl;
+    f_code_s += l_plot_ss.str();
+  } else { // matrix plot with coordinates of bin centers
+    l_plot_ss << "\\addplot [matrix plot*, mesh/cols=" << l_binsX_i << ", mesh/rows=" << l_binsY_i << ", point meta=explicit]" << std::endl;
+    l_plot_ss << "  table[row sep=crcr, meta index=2]{%" << std::endl;
+    f_code_s += l_plot_ss.str();
+    char l_buffer_pc[96];
+    for (std::size_t l_binY_i = 0; l_binY_i < l_binsY_i; ++l_binY_i) {
+      double l_y_d = l_minY_d + (l_binY_i + 0.5) / l_scaleY_d;
+      l_y_d = m_logOnY_b ? std::pow(10.0, l_y_d) : l_y_d;
+      for (std::size_t l_binX_i = 0; l_binX_i < l_binsX_i; ++l_binX_i) {
+        double l_x_d = l_minX_d + (l_binX_i + 0.5) / l_scaleX_d;
+        l_x_d = m_logOnX_b ? std::pow(10.0, l_x_d) : l_x_d;
+        int l_len_i = std::snprintf(l_buffer_pc, sizeof(l_buffer_pc), "%g\t%g\t%llu\\\\\n", l_x_d, l_y_d,
+                                    static_cast<unsigned long long>(l_count_v[l_binY_i * l_binsX_i + l_binX_i]));
+        f_code_s.append(l_buffer_pc, l_len_i);
+      }
+    }
+    f_code_s += "};\n";
+  }
+}
+
+
+// ========================================================================
+// write box plot of each data set entry. Quartiles are selected with
+// nth_element (linear interpolation between order statistics), whiskers
+// end at most extreme values within 1.5 interquartile range. Outliers are
+// thinned out evenly when there are more than the maximum number.
+// ========================================================================
+void CTikz::m_writeBox_vd(std::string& f_code_s,
+                          const gType_TIKZ_PlotParam_st& f_plotParam_st)
+{
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    const gType_TIKZ_DataSet_st& l_dataSetEntry_st = m_dataSet_v[l_k_i];
+    std::stringstream l_plot_ss;
+    if ("" != l_dataSetEntry_st.comment_s) {
+      l_plot_ss << "% " << l_dataSetEntry_st.comment_s << std::endl;
+    }
+    std::vector<double> l_data_v;
+    l_data_v.reserve(l_dataSetEntry_st.y_p->size());
+    CFilter l_filter_c(*l_dataSetEntry_st.y_p);
+    g_addFilters_vd(l_filter_c, l_dataSetEntry_st.filter_v);
+    for (std::size_t l_n_i = 0; l_n_i < l_dataSetEntry_st.y_p->size(); ++l_n_i) {
+      const double l_y_d = l_filter_c.next_d();
+      if (std::isfinite(l_y_d)) {
+        l_data_v.push_back(l_y_d);
+      }
+    }
+    if (l_data_v.empty()) {
+      l_plot_ss << "% no values for box plot" << std::endl;
+      f_code_s += l_plot_ss.str();
+      continue;
+    }
+    
+    // quartiles in ascending order: each selection only needs to look at the upper part
+    double l_quartile_pd[3];
+    std::size_t l_begin_i = 0;
+    for (int l_q_i = 0; l_q_i < 3; ++l_q_i) {
+      l_quartile_pd[l_q_i] = g_quantile_d(l_data_v, (l_q_i + 1) * 0.25, l_begin_i);
+    }
+    const double l_iqr_d = l_quartile_pd[2] - l_quartile_pd[0];
+    const double l_lowerFence_d = l_quartile_pd[0] - 1.5 * l_iqr_d;
+    const double l_upperFence_d = l_quartile_pd[2] + 1.5 * l_iqr_d;
+    double l_lowerWhisker_d = l_quartile_pd[0];
+    double l_upperWhisker_d = l_quartile_pd[2];
+    std::vector<double> l_outlier_v;
+    for (std::vector<double>::const_iterator l_data_it = l_data_v.begin(); l_data_it != l_data_v.end(); ++l_data_it) {
+      if ((*l_data_it < l_lowerFence_d) || (*l_data_it > l_upperFence_d)) {
+        l_outlier_v.push_back(*l_data_it);
+      } else {
+        l_lowerWhisker_d = std::min(l_lowerWhisker_d, *l_data_it);
+        l_upperWhisker_d = std::max(l_upperWhisker_d, *l_data_it);
+      }
+    }
+    std::sort(l_outlier_v.begin(), l_outlier_v.end());
+    const std::size_t l_maxOutliers_i = static_cast<std::size_t>(f_plotParam_st.maxOutliers_i);
+    
+    l_plot_ss << "% box plot of " << l_data_v.size() << " values, ";
+    l_plot_ss << std::min(l_outlier_v.size(), l_maxOutliers_i) << " of " << l_outlier_v.size() << " outliers shown" << std::endl;
+    l_plot_ss << "\\addplot+ [color=" << l_dataSetEntry_st.color_s << "," << l_dataSetEntry_st.plotStyle_s << ",";
+    l_plot_ss << " boxplot prepared={" << std::endl;
+    l_plot_ss << "    draw position=" << l_k_i + 1 << "," << std::endl;
+    l_plot_ss << "    lower whisker=" << l_lowerWhisker_d << "," << std::endl;
+    l_plot_ss << "    lower quartile=" << l_quartile_pd[0] << "," << std::endl;
+    l_plot_ss << "    median=" << l_quartile_pd[1] << "," << std::endl;
+    l_plot_ss << "    upper quartile=" << l_quartile_pd[2] << "," << std::endl;
+    l_plot_ss << "    upper whisker=" << l_upperWhisker_d << std::endl;
+    l_plot_ss << " }]" << std::endl;
+    if ((0 == l_maxOutliers_i) || l_outlier_v.empty()) {
+      l_plot_ss << "  coordinates {};" << std::endl;
+    } else {
+      l_plot_ss << "  table[row sep=crcr, y index=0]{%" << std::endl;
+      if (l_outlier_v.size() <= l_maxOutliers_i) {
+        for (std::size_t l_o_i = 0; l_o_i < l_outlier_v.size(); ++l_o_i) {
+          l_plot_ss << l_outlier_v[l_o_i] << "\\\\" << std::endl;
+        }
+      } else if (1 == l_maxOutliers_i) { // most extreme outlier
+        const double l_low_d = l_quartile_pd[1] - l_outlier_v.front();
+        const double l_high_d = l_outlier_v.back() - l_quartile_pd[1];
+        l_plot_ss << ((l_low_d > l_high_d) ? l_outlier_v.front() : l_outlier_v.back()) << "\\\\" << std::endl;
+      } else { // evenly spread, smallest and largest outlier included
+        for (std::size_t l_o_i = 0; l_o_i < l_maxOutliers_i; ++l_o_i) {
+          l_plot_ss << l_outlier_v[l_o_i * (l_outlier_v.size() - 1) / (l_maxOutliers_i - 1)] << "\\\\" << std::endl;
+        }
+      }
+      l_plot_ss << "};" << std::endl;
+    }
+    f_code_s += l_plot_ss.str();
+  }
+}
+
+
+// ========================================================================
+// get default parameters of graphics for given type
+// ========================================================================
+gType_TIKZ_PlotParam_st CTikz::m_createPlotParam_st(gType_TIKZ_PlotType_e f_plotType_e)
+{
+  gType_TIKZ_PlotParam_st l_plotParam_st;
+  l_plotParam_st.type_e = f_plotType_e;
+  l_plotParam_st.bins_i = 0;
+  l_plotParam_st.binsY_i = 0;
+  l_plotParam_st.dataMin_d = 0;
+  l_plotParam_st.dataMax_d = 0;
+  l_plotParam_st.raster_b = false;
+  l_plotParam_st.maxOutliers_i = 0;
+  l_plotParam_st.groupPanel_b = false;
+  l_plotParam_st.sharedX_b = false;
+  l_plotParam_st.sharedY_b = false;
+  return l_plotParam_st;
+}
+
+
+// ========================================================================
+// get render cache (table and bounds) of data set entry. Cache is only
+// recreated when data set entry is dirty or format of tables changed
+// (precision relative to axis depends on range of all data set entries).
+// ========================================================================
+const gType_TIKZ_DataSetCache_st& CTikz::m_getCache_st(std::size_t f_idx_i)
+{
+  m_getBounds_st(f_idx_i);
+  gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  const gType_TIKZ_NumberFormat_st l_formatX_st = m_getNumberFormat_st(false);
+  const gType_TIKZ_NumberFormat_st l_formatY_st = m_getNumberFormat_st(true, m_isSecondAxis_b(l_dataSet_st));
+  const gType_TIKZ_DataSetCache_st& l_cache_st = *l_dataSet_st.cache_p;
+  if (!l_cache_st.table_b ||
+      (l_formatX_st.digits_i != l_cache_st.formatX_st.digits_i) || (l_formatX_st.quantum_d != l_cache_st.formatX_st.quantum_d) ||
+      (l_formatY_st.digits_i != l_cache_st.formatY_st.digits_i) || (l_formatY_st.quantum_d != l_cache_st.formatY_st.quantum_d)) {
+    const bool l_createTable_b = true;
+    l_dataSet_st.cache_p = m_createCache_p(l_dataSet_st, l_createTable_b);
+  }
+  return *l_dataSet_st.cache_p;
+}
+
+
+// ========================================================================
+// get render cache with at least bounds of data set entry. Bounds and
+// table are created within one pass over data unless format of table
+// depends on range of axis.
+// ========================================================================
+const gType_TIKZ_DataSetCache_st& CTikz::m_getBounds_st(std::size_t f_idx_i)
+{
+  gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  if (!l_dataSet_st.cache_p) {
+    // column of common table needs no own table
+    const bool l_createTable_b = (e_TIKZ_PrecisionAxis != m_precision_e) && !m_isSharedX_b(f_idx_i);
+    l_dataSet_st.cache_p = m_createCache_p(l_dataSet_st, l_createTable_b);
+  }
+  return *l_dataSet_st.cache_p;
+}
+
+
+// ========================================================================
+// data set entry is line plot with own table and another line plot with
+// own table of same y axis references the same x column
+// ========================================================================
+bool CTikz::m_isSharedX_b(std::size_t f_idx_i) const
+{
+  const gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  if (!l_dataSet_st.x_p || !g_isLineTable_b(l_dataSet_st, m_chunkSize_i)) { // uniform grid has no x column
+    return false;
+  }
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    if ((l_k_i != f_idx_i) && (m_dataSet_v[l_k_i].x_p == l_dataSet_st.x_p) && g_isLineTable_b(m_dataSet_v[l_k_i], m_chunkSize_i) &&
+        (m_dataSet_v[l_k_i].secondAxis_b == l_dataSet_st.secondAxis_b)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// ========================================================================
+// get common table of data set entries with same x column (one table per
+// y axis). Columns are immutable, i.e. cached table is valid as long as it
+// references the same columns with same format (tables are removed when
+// filters change). Tables of x columns which are not used any longer are
+// removed.
+// ========================================================================
+const std::string& CTikz::m_getSharedTable_s(const std::vector<std::size_t>& f_idx_v)
+{
+  const gType_TIKZ_Column_p& l_dataX_p = m_dataSet_v.at(f_idx_v.front()).x_p;
+  const bool l_secondAxis_b = m_dataSet_v.at(f_idx_v.front()).secondAxis_b;
+  std::vector<gType_TIKZ_Column_p> l_dataY_v;
+  std::vector<CFilter> l_filter_v; // filters of y columns run while rows are written
+  for (std::size_t l_k_i = 0; l_k_i < f_idx_v.size(); ++l_k_i) {
+    const gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_v[l_k_i]);
+    l_dataY_v.push_back(l_dataSet_st.y_p);
+    l_filter_v.push_back(CFilter(*l_dataSet_st.y_p));
+    g_addFilters_vd(l_filter_v.back(), l_dataSet_st.filter_v);
+  }
+  const gType_TIKZ_NumberFormat_st l_formatX_st = m_getNumberFormat_st(false);
+  const gType_TIKZ_NumberFormat_st l_formatY_st = m_getNumberFormat_st(true, m_isSecondAxis_b(m_dataSet_v.at(f_idx_v.front())));
+  
+  std::size_t l_found_i = 0;
+  while ((l_found_i < m_sharedTable_v.size()) &&
+         ((m_sharedTable_v[l_found_i].x_p != l_dataX_p) || (m_sharedTable_v[l_found_i].secondAxis_b != l_secondAxis_b))) {
+    ++l_found_i;
+  }
+  if (l_found_i < m_sharedTable_v.size()) {
+    const gType_TIKZ_SharedTable_st& l_table_st = m_sharedTable_v[l_found_i];
+    if ((l_table_st.y_v == l_dataY_v) &&
+        (l_formatX_st.digits_i == l_table_st.formatX_st.digits_i) && (l_formatX_st.quantum_d == l_table_st.formatX_st.quantum_d) &&
+        (l_formatY_st.digits_i == l_table_st.formatY_st.digits_i) && (l_formatY_st.quantum_d == l_table_st.formatY_st.quantum_d)) {
+      return l_table_st.table_s;
+    }
+  } else {
+    for (std::size_t l_k_i = m_sharedTable_v.size(); l_k_i > 0; --l_k_i) {
+      if (m_sharedTable_v[l_k_i - 1].x_p.unique()) { // only referenced by cache
+        m_sharedTable_v.erase(m_sharedTable_v.begin() + (l_k_i - 1));
+      }
+    }
+    l_found_i = m_sharedTable_v.size();
+    m_sharedTable_v.push_back(gType_TIKZ_SharedTable_st());
+  }
+  
+  gType_TIKZ_SharedTable_st& l_table_st = m_sharedTable_v[l_found_i];
+  l_table_st.x_p = l_dataX_p;
+  l_table_st.secondAxis_b = l_secondAxis_b;
+  l_table_st.y_v = l_dataY_v;
+  l_table_st.formatX_st = l_formatX_st;
+  l_table_st.formatY_st = l_formatY_st;
+  l_table_st.table_s.clear();
+  const std::vector<double>& l_valueX_v = *l_dataX_p;
+  l_table_st.table_s.reserve(l_valueX_v.size() * 12 * (l_dataY_v.size() + 1));
+  char l_buffer_pc[32];
+  const bool l_uniformX_b = m_getBounds_st(f_idx_v.front()).uniformX_b; // x column is left out
+  for (std::size_t l_n_i = 0; l_n_i < l_valueX_v.size(); ++l_n_i) {
+    if (!l_uniformX_b) {
+      l_table_st.table_s.append(l_buffer_pc, g_formatValue_i(l_buffer_pc, sizeof(l_buffer_pc), l_valueX_v[l_n_i], l_formatX_st));
+    }
+    for (std::size_t l_k_i = 0; l_k_i < l_dataY_v.size(); ++l_k_i) {
+      if (!l_uniformX_b || (l_k_i > 0)) {
+        l_table_st.table_s += '\t';
+      }
+      l_table_st.table_s.append(l_buffer_pc, g_formatValue_i(l_buffer_pc, sizeof(l_buffer_pc), l_filter_v[l_k_i].next_d(), l_formatY_st));
+    }
+    l_table_st.table_s += "\\\\\n";
+  }
+  return l_table_st.table_s;
+}
+
+
+// ========================================================================
+// get format of coordinates of axis in tables. Precision relative to axis:
+// size of one dot is range of axis divided by number of dots of plot,
+// coordinates are rounded to power of ten below size of one dot. Number of
+// significant digits is sufficient for largest value of axis.
+// ========================================================================
+gType_TIKZ_NumberFormat_st CTikz::m_getNumberFormat_st(bool f_axisY_b, bool f_secondAxis_b)
+{
+  gType_TIKZ_NumberFormat_st l_format_st;
+  l_format_st.digits_i = 6;
+  l_format_st.quantum_d = 0;
+  if (e_TIKZ_PrecisionDigits == m_precision_e) {
+    l_format_st.digits_i = std::max(1, std::min(17, static_cast<int>(m_precisionValue_d)));
+  } else if (e_TIKZ_PrecisionAxis == m_precision_e) {
+    const double l_min_d = !f_axisY_b ? m_getMinX_d() : (f_secondAxis_b ? m_getMinY2_d() : m_getMinY_d());
+    const double l_max_d = !f_axisY_b ? m_getMaxX_d() : (f_secondAxis_b ? m_getMaxY2_d() : m_getMaxY_d());
+    const bool l_log_b = f_axisY_b ? (m_logOnY_b && !f_secondAxis_b) : m_logOnX_b; // second y axis is linear
+    const double l_dpi_d = (m_precisionValue_d > 0) ? m_precisionValue_d : m_rasterResolution_d;
+    const double l_dots_d = std::max(1.0, m_getLengthInch_d(f_axisY_b ? m_height_s : m_width_s) * l_dpi_d);
+    if (l_log_b && (l_min_d > 0) && (l_max_d > l_min_d)) {
+      // relative size of one dot is equal for all values
+      const double l_relative_d = std::log(l_max_d / l_min_d) / l_dots_d;
+      l_format_st.digits_i = static_cast<int>(std::ceil(-std::log10(l_relative_d))) + 1;
+    } else if (l_max_d > l_min_d) {
+      l_format_st.quantum_d = std::pow(10.0, std::floor(std::log10((l_max_d - l_min_d) / l_dots_d)));
+      const double l_maxAbs_d = std::max(std::fabs(l_min_d), std::fabs(l_max_d));
+      l_format_st.digits_i = static_cast<int>(std::floor(std::log10(l_maxAbs_d)) - std::log10(l_format_st.quantum_d)) + 1;
+    }
+    l_format_st.digits_i = std::max(1, std::min(17, l_format_st.digits_i));
+  }
+  return l_format_st;
+}
+
+
+// ========================================================================
+// create render cache (bounds and optional table) of data set entry within
+// one pass over data
+// ========================================================================
+std::shared_ptr<const gType_TIKZ_DataSetCache_st> CTikz::m_createCache_p(const gType_TIKZ_DataSet_st& f_dataSet_st,
+                                                                         bool f_createTable_b)
+{
+  const std::vector<double>& l_dataY_v = *f_dataSet_st.y_p;
+  if (l_dataY_v.empty()) {
+    throw CException("CTikz::getCache(): data size is 0.");
+  }
+  // x values of uniform grid are computed
+  const std::vector<double>* l_dataX_pv = f_dataSet_st.x_p.get();
+  auto l_getX_d = [&](std::size_t f_k_i) -> double {
+    return l_dataX_pv ? (*l_dataX_pv)[f_k_i] : f_dataSet_st.startX_d + f_k_i * f_dataSet_st.stepX_d;
+  };
+  
+  std::shared_ptr<gType_TIKZ_DataSetCache_st> l_cache_p = std::make_shared<gType_TIKZ_DataSetCache_st>();
+  gType_TIKZ_DataSetCache_st& l_cache_st = *l_cache_p;
+  // default precision (6 digits, %g) keeps output identical to std::ostream
+  char l_buffer_pc[96];
+  l_cache_st.table_b = f_createTable_b;
+  l_cache_st.formatX_st.digits_i = 0;
+  l_cache_st.formatX_st.quantum_d = 0;
+  l_cache_st.formatY_st = l_cache_st.formatX_st;
+  // rows of raster graphics are not needed, band of envelope is written anyway
+  const bool l_createRows_b = f_createTable_b && !f_dataSet_st.raster_b;
+  if (f_createTable_b) {
+    l_cache_st.formatX_st = m_getNumberFormat_st(false);
+    l_cache_st.formatY_st = m_getNumberFormat_st(true, m_isSecondAxis_b(f_dataSet_st));
+  }
+  if (l_createRows_b) {
+    l_cache_st.table_s.reserve(l_dataY_v.size() * 24);
+  }
+  // uniform grid: given by user or at least three x values which are exactly on grid
+  if (l_dataX_pv) {
+    const std::vector<double>& l_dataX_v = *l_dataX_pv;
+    const std::size_t l_last_i = l_dataX_v.size() - 1;
+    l_cache_st.startX_d = l_dataX_v.front();
+    l_cache_st.stepX_d = (l_last_i > 0) ? (l_dataX_v[l_last_i] - l_dataX_v.front()) / l_last_i : 0;
+    l_cache_st.uniformX_b = (l_last_i >= 2) && (0 != l_cache_st.stepX_d) && std::isfinite(l_cache_st.stepX_d) && !f_dataSet_st.error_p;
+    for (std::size_t l_k_i = 0; (l_k_i <= l_last_i) && l_cache_st.uniformX_b; ++l_k_i) {
+      l_cache_st.uniformX_b = (l_dataX_v[l_k_i] == l_cache_st.startX_d + l_k_i * l_cache_st.stepX_d);
+    }
+  } else {
+    l_cache_st.startX_d = f_dataSet_st.startX_d;
+    l_cache_st.stepX_d = f_dataSet_st.stepX_d;
+    l_cache_st.uniformX_b = true;
+  }
+  // points with value which is not finite are gaps: not part of bounds, plot is interrupted
+  // by one gap row between finite points (rows of uniform grid are kept for index of row)
+  l_cache_st.minX_d = std::numeric_limits<double>::infinity();
+  l_cache_st.maxX_d = -std::numeric_limits<double>::infinity();
+  l_cache_st.minY_d = std::numeric_limits<double>::infinity();
+  l_cache_st.maxY_d = -std::numeric_limits<double>::infinity();
+  l_cache_st.gaps_i = 0;
+  bool l_finite_b = false; // finite point before
+  bool l_gap_b = false; // gap after last finite point
+  // error bars: third column of table, bounds include error bars (error which is not finite is no error bar)
+  const std::vector<double>* l_error_pv = f_dataSet_st.error_p ? f_dataSet_st.error_p.get() : NULL;
+  // filters run in same pass, bounds and rows are filtered values
+  CFilter l_filter_c(l_dataY_v);
+  g_addFilters_vd(l_filter_c, f_dataSet_st.filter_v);
+  for (std::size_t l_k_i = 0; l_k_i < l_dataY_v.size(); ++l_k_i) {
+    const double l_x_d = l_getX_d(l_k_i);
+    const double l_y_d = l_filter_c.next_d();
+    if (!std::isfinite(l_x_d) || !std::isfinite(l_y_d)) {
+      l_gap_b = l_finite_b;
+      if (l_createRows_b && l_cache_st.uniformX_b) {
+        l_cache_st.table_s += "nan\\\\\n";
+      }
+      continue;
+    }
+    if (l_gap_b) {
+      ++l_cache_st.gaps_i;
+      l_gap_b = false;
+      if (l_createRows_b && !l_cache_st.uniformX_b) {
+        l_cache_st.table_s += l_error_pv ? "nan\tnan\tnan\\\\\n" : "nan\tnan\\\\\n";
+      }
+    }
+    l_finite_b = true;
+    if (l_x_d < l_cache_st.minX_d) {
+      l_cache_st.minX_d = l_x_d;
+    }
+    if (l_x_d > l_cache_st.maxX_d) {
+      l_cache_st.maxX_d = l_x_d;
+    }
+    if (l_y_d < l_cache_st.minY_d) {
+      l_cache_st.minY_d = l_y_d;
+    }
+    if (l_y_d > l_cache_st.maxY_d) {
+      l_cache_st.maxY_d = l_y_d;
+    }
+    if (l_error_pv) {
+      const double l_error_d = std::isfinite((*l_error_pv)[l_k_i]) ? std::fabs((*l_error_pv)[l_k_i]) : 0;
+      l_cache_st.minY_d = std::min(l_cache_st.minY_d, l_y_d - l_error_d);
+      l_cache_st.maxY_d = std::max(l_cache_st.maxY_d, l_y_d + l_error_d);
+      if (l_createRows_b) {
+        l_cache_st.table_s.append(l_buffer_pc, g_formatRowError_i(l_buffer_pc, sizeof(l_buffer_pc), l_x_d, l_y_d, l_error_d,
+                                                                  l_cache_st.formatX_st, l_cache_st.formatY_st));
+      }
+    } else if (l_createRows_b) {
+      const int l_len_i = l_cache_st.uniformX_b ?
+        g_formatRowY_i(l_buffer_pc, sizeof(l_buffer_pc), l_y_d, l_cache_st.formatY_st) :
+        g_formatRow_i(l_buffer_pc, sizeof(l_buffer_pc), l_x_d, l_y_d, l_cache_st.formatX_st, l_cache_st.formatY_st);
+      l_cache_st.table_s.append(l_buffer_pc, l_len_i);
+    }
+  }
+  if (f_dataSet_st.lower_p && f_dataSet_st.upper_p) { // band of envelope is vector graphics in any case
+    const std::vector<double>& l_lower_v = *f_dataSet_st.lower_p;
+    const std::vector<double>& l_upper_v = *f_dataSet_st.upper_p;
+    if (f_createTable_b) {
+      l_cache_st.lowerTable_s.reserve(l_dataY_v.size() * 24);
+      l_cache_st.upperTable_s.reserve(l_dataY_v.size() * 24);
+    }
+    // band is not interrupted, points which are not finite are left out
+    for (std::size_t l_k_i = 0; l_k_i < l_dataY_v.size(); ++l_k_i) {
+      const double l_x_d = l_getX_d(l_k_i);
+      if (!std::isfinite(l_x_d) || !std::isfinite(l_lower_v[l_k_i]) || !std::isfinite(l_upper_v[l_k_i])) {
+        if (f_createTable_b && l_cache_st.uniformX_b) {
+          l_cache_st.lowerTable_s += "nan\\\\\n";
+          l_cache_st.upperTable_s += "nan\\\\\n";
+        }
+        continue;
+      }
+      l_cache_st.minY_d = std::min(l_cache_st.minY_d, l_lower_v[l_k_i]);
+      l_cache_st.maxY_d = std::max(l_cache_st.maxY_d, l_upper_v[l_k_i]);
+      if (f_createTable_b && l_cache_st.uniformX_b) {
+        l_cache_st.lowerTable_s.append(l_buffer_pc, g_formatRowY_i(l_buffer_pc, sizeof(l_buffer_pc), l_lower_v[l_k_i], l_cache_st.formatY_st));
+        l_cache_st.upperTable_s.append(l_buffer_pc, g_formatRowY_i(l_buffer_pc, sizeof(l_buffer_pc), l_upper_v[l_k_i], l_cache_st.formatY_st));
+      } else if (f_createTable_b) {
+        int l_len_i = g_formatRow_i(l_buffer_pc, sizeof(l_buffer_pc), l_x_d, l_lower_v[l_k_i],
+                                    l_cache_st.formatX_st, l_cache_st.formatY_st);
+        l_cache_st.lowerTable_s.append(l_buffer_pc, l_len_i);
+        l_len_i = g_formatRow_i(l_buffer_pc, sizeof(l_buffer_pc), l_x_d, l_upper_v[l_k_i],
+                                l_cache_st.formatX_st, l_cache_st.formatY_st);
+        l_cache_st.upperTable_s.append(l_buffer_pc, l_len_i);
+      }
+    }
+  }
+  return l_cache_p;
+}
+
+
+// ========================================================================
+// render data set entry into PNG file. Image covers axis range with size of
+// plot (scale only axis) and given resolution. Points are distributed over
+// threads, all threads draw into one coverage mask (coverage of pixel is
+// raised atomically), i.e. memory does not grow with number of threads.
+// ========================================================================
+void CTikz::m_writeRaster_vd(std::size_t f_idx_i, const std::string& f_filename_s)
+{
+  const gType_TIKZ_DataSet_st& l_dataSet_st = m_dataSet_v.at(f_idx_i);
+  const unsigned int l_width_i = static_cast<unsigned int>(std::ceil(m_getLengthInch_d(m_width_s) * m_rasterResolution_d));
+  const unsigned int l_height_i = static_cast<unsigned int>(std::ceil(m_getLengthInch_d(m_height_s) * m_rasterResolution_d));
+  if ((0 == l_width_i) || (0 == l_height_i)) {
+    throw CException("CTikz::writeRaster(): size of raster graphics is 0.");
+  }
+  const double l_radius_d = l_dataSet_st.rasterMarkSize_d / 72.27 * m_rasterResolution_d;
+  
+  // axis range, transformed for log scale (second y axis is linear)
+  const bool l_secondAxis_b = m_isSecondAxis_b(l_dataSet_st);
+  const bool l_logY_b = m_logOnY_b && !l_secondAxis_b;
+  double l_minX_d = m_getMinX_d();
+  double l_maxX_d = m_getMaxX_d();
+  double l_minY_d = l_secondAxis_b ? m_getMinY2_d() : m_getMinY_d();
+  double l_maxY_d = l_secondAxis_b ? m_getMaxY2_d() : m_getMaxY_d();
+  if (m_logOnX_b) {
+    l_minX_d = std::log10(l_minX_d);
+    l_maxX_d = std::log10(l_maxX_d);
+  }
+  if (l_logY_b) {
+    l_minY_d = std::log10(l_minY_d);
+    l_maxY_d = std::log10(l_maxY_d);
+  }
+  const double l_scaleX_d = (l_maxX_d > l_minX_d) ? l_width_i / (l_maxX_d - l_minX_d) : 0;
+  const double l_scaleY_d = (l_maxY_d > l_minY_d) ? l_height_i / (l_maxY_d - l_minY_d) : 0;
+  
+  const gType_TIKZ_Column_p l_dataX_p = g_getColumnX_p(l_dataSet_st);
+  const std::vector<double>& l_dataX_v = *l_dataX_p;
+  const gType_TIKZ_Column_p l_dataY_p = g_getColumnY_p(l_dataSet_st);
+  const std::vector<double>& l_dataY_v = *l_dataY_p;
+  const std::size_t l_numPixels_i = static_cast<std::size_t>(l_width_i) * l_height_i;
+  std::vector<std::atomic<unsigned char> > l_mask_v(l_numPixels_i);
+  CParallel::for_vd(l_dataX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      double l_x_d = l_dataX_v[l_k_i];
+      double l_y_d = l_dataY_v[l_k_i];
+      if ((m_logOnX_b && !(l_x_d > 0)) || (l_logY_b && !(l_y_d > 0))) {
+        continue;
+      }
+      l_x_d = ((m_logOnX_b ? std::log10(l_x_d) : l_x_d) - l_minX_d) * l_scaleX_d;
+      l_y_d = l_height_i - ((l_logY_b ? std::log10(l_y_d) : l_y_d) - l_minY_d) * l_scaleY_d;
+      if (!(l_x_d > -l_radius_d - 1) || !(l_x_d < l_width_i + l_radius_d + 1) ||
+          !(l_y_d > -l_radius_d - 1) || !(l_y_d < l_height_i + l_radius_d + 1)) {
+        continue; // outside of axis range or not finite
+      }
+      // filled circle, edge is anti-aliased by distance to pixel center
+      const int l_col0_i = std::max(0, static_cast<int>(std::floor(l_x_d - l_radius_d - 0.5)));
+      const int l_col1_i = std::min(static_cast<int>(l_width_i) - 1, static_cast<int>(std::floor(l_x_d + l_radius_d + 0.5)));
+      const int l_row0_i = std::max(0, static_cast<int>(std::floor(l_y_d - l_radius_d - 0.5)));
+      const int l_row1_i = std::min(static_cast<int>(l_height_i) - 1, static_cast<int>(std::floor(l_y_d + l_radius_d + 0.5)));
+      for (int l_row_i = l_row0_i; l_row_i <= l_row1_i; ++l_row_i) {
+        const double l_dy_d = l_row_i + 0.5 - l_y_d;
+        for (int l_col_i = l_col0_i; l_col_i <= l_col1_i; ++l_col_i) {
+          const double l_dx_d = l_col_i + 0.5 - l_x_d;
+          const double l_coverage_d = l_radius_d + 0.5 - std::sqrt(l_dx_d * l_dx_d + l_dy_d * l_dy_d);
+          if (l_coverage_d > 0) {
+            const unsigned char l_alpha_i = (l_coverage_d >= 1) ? 255 : static_cast<unsigned char>(l_coverage_d * 255);
+            std::atomic<unsigned char>& l_pixel_i = l_mask_v[static_cast<std::size_t>(l_row_i) * l_width_i + l_col_i];
+            unsigned char l_old_i = l_pixel_i.load(std::memory_order_relaxed);
+            while ((l_alpha_i > l_old_i) && !l_pixel_i.compare_exchange_weak(l_old_i, l_alpha_i, std::memory_order_relaxed)) {
+              // l_old_i is updated to current coverage, loop ends when coverage is at least l_alpha_i
+            }
+          }
+        }
+      }
+    }
+  });
+  
+  // coverage mask into RGBA image (threads of loop above are joined)
+  unsigned char l_rgb_pi[3];
+  m_getColorRgb_vd(l_dataSet_st.color_s, l_rgb_pi);
+  std::vector<unsigned char> l_rgba_v(l_numPixels_i * 4);
+  CParallel::for_vd(l_numPixels_i, [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      l_rgba_v[4 * l_k_i] = l_rgb_pi[0];
+      l_rgba_v[4 * l_k_i + 1] = l_rgb_pi[1];
+      l_rgba_v[4 * l_k_i + 2] = l_rgb_pi[2];
+      l_rgba_v[4 * l_k_i + 3] = l_mask_v[l_k_i].load(std::memory_order_relaxed);
+    }
+  });
+  CPng::write_vd(f_filename_s, l_width_i, l_height_i, l_rgba_v);
+}
+
+
+// ========================================================================
+// convert length like "10cm" into inch (units: in, cm, mm, pt, bp, pc)
+// ========================================================================
+double CTikz::m_getLengthInch_d(const std::string& f_length_s)
+{
+  std::istringstream l_length_ss(f_length_s);
+  double l_value_d = 0;
+  std::string l_unit_s;
+  if (!(l_length_ss >> l_value_d)) {
+    l_unit_s = "?";
+  } else {
+    l_length_ss >> l_unit_s;
+  }
+  if ("in" == l_unit_s) {
+    return l_value_d;
+  } else if ("cm" == l_unit_s) {
+    return l_value_d / 2.54;
+  } else if ("mm" == l_unit_s) {
+    return l_value_d / 25.4;
+  } else if ("pt" == l_unit_s) {
+    return l_value_d / 72.27;
+  } else if ("bp" == l_unit_s) {
+    return l_value_d / 72.0;
+  } else if ("pc" == l_unit_s) {
+    return l_value_d * 12.0 / 72.27;
+  }
+  std::stringstream l_msg_ss;
+  l_msg_ss << "CTikz::getLength(): cannot convert \"" << f_length_s << "\", absolute length (e.g. 10cm) is needed.";
+  throw CException(l_msg_ss.str());
+}
+
+
+// ========================================================================
+// get RGB values of color. Colors defined via \definecolor{name}{RGB}{r,g,b}
+// or \definecolor{name}{rgb}{r,g,b} in additional latex commands are used
+// first, then default colors of CTikz and base colors of xcolor. Unknown
+// colors are black.
+// ========================================================================
+void CTikz::m_getColorRgb_vd(const std::string& f_color_s, unsigned char* f_rgb_p)
+{
+  f_rgb_p[0] = 0;
+  f_rgb_p[1] = 0;
+  f_rgb_p[2] = 0;
+  
+  const std::string l_define_s = "\\definecolor{" + f_color_s + "}{";
+  std::string::size_type l_found_i = m_additionalLatexCommands_s.rfind(l_define_s);
+  if (std::string::npos != l_found_i) {
+    std::string l_model_s;
+    double l_value_pd[3] = {0, 0, 0};
+    std::istringstream l_define_ss(m_additionalLatexCommands_s.substr(l_found_i + l_define_s.size()));
+    char l_sep_c = 0;
+    if (std::getline(l_define_ss, l_model_s, '}') && (l_define_ss >> l_sep_c) && ('{' == l_sep_c) &&
+        (l_define_ss >> l_value_pd[0] >> l_sep_c >> l_value_pd[1] >> l_sep_c >> l_value_pd[2])) {
+      const double l_scale_d = ("rgb" == l_model_s) ? 255.0 : 1.0;
+      if (("RGB" == l_model_s) || ("rgb" == l_model_s)) {
+        for (int l_k_i = 0; l_k_i < 3; ++l_k_i) {
+          f_rgb_p[l_k_i] = static_cast<unsigned char>(std::min(255.0, std::max(0.0, l_value_pd[l_k_i] * l_scale_d + 0.5)));
+        }
+        return;
+      }
+    }
+  }
+  
+  static const char* l_name_ppc[] = {"ctikzColorBlue", "ctikzColorRed", "ctikzColorGreen", "ctikzColorYellow",
+    "black", "white", "red", "green", "blue", "cyan", "magenta", "yellow", "gray", "darkgray", "lightgray",
+    "brown", "lime", "olive", "orange", "pink", "purple", "teal", "violet"};
+  static const unsigned char l_rgb_ppi[][3] = {{0, 150, 230}, {250, 30, 0}, {100, 200, 60}, {250, 210, 0},
+    {0, 0, 0}, {255, 255, 255}, {255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {0, 255, 255}, {255, 0, 255}, {255, 255, 0}, {128, 128, 128}, {64, 64, 64}, {191, 191, 191},
+    {191, 128, 64}, {191, 255, 0}, {128, 128, 0}, {255, 128, 0}, {255, 191, 191}, {191, 0, 64}, {0, 128, 128}, {128, 0, 128}};
+  for (std::size_t l_k_i = 0; l_k_i < sizeof(l_name_ppc) / sizeof(l_name_ppc[0]); ++l_k_i) {
+    if (f_color_s == l_name_ppc[l_k_i]) {
+      f_rgb_p[0] = l_rgb_ppi[l_k_i][0];
+      f_rgb_p[1] = l_rgb_ppi[l_k_i][1];
+      f_rgb_p[2] = l_rgb_ppi[l_k_i][2];
+      return;
+    }
+  }
+}
+
+
+// ========================================================================
+// add data set entry, its render cache is dirty
+// ========================================================================
+void CTikz::m_pushDataSet_vd(const gType_TIKZ_DataSet_st& f_dataSet_st)
+{
+  m_dataSet_v.push_back(f_dataSet_st);
+  m_dataSet_v.back().cache_p.reset();
+  // auto range might change
+  m_settingsDirty_b = true;
+}
+
+
 // ========================================================================
-// set additional settings for tikz file (old settings are cleared)
+// remove all data set entries and their render caches
 // ========================================================================
-void CTikz::setAdditionalSettings_vd(const std::string& f_settings_s)
+void CTikz::m_clearDataSet_vd()
 {
-  m_additionalSettings_v.clear();
-  addAdditionalSettings_vd(f_settings_s);
+  m_dataSet_v.clear();
+  m_sharedTable_v.clear();
+  m_timeData_b = false;
+  m_settingsDirty_b = true;
+}
+
+
+// ========================================================================
+// create PDF file. Latex file is compiled in private scratch directory,
+// tikz file and its graphics are found via TEXINPUTS. Only PDF file (and
+// latex file) is moved next to tikz file, log file only in case of error.
+// With TeX worker only document body is fed into waiting engine.
+// ========================================================================
+void CTikz::m_createPdf_vd(const std::string& f_filenameTikz_s)
+{
+  std::string l_filenameBase_s = f_filenameTikz_s;
+  std::string::size_type l_found_i = l_filenameBase_s.rfind(".");
+  if (std::string::npos != l_found_i) {
+    l_filenameBase_s = l_filenameBase_s.substr(0, l_found_i);
+  }
+  std::string l_filenameTex_s = l_filenameBase_s;
+  l_filenameTex_s += ".tex";
+  if (m_keepTex_b && m_fileExist_b(l_filenameTex_s)) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "File \"" << l_filenameTex_s << "\" already exists.";
+    throw CException(l_msg_ss.str());
+  }
+  // determine directory/path
+  l_found_i = f_filenameTikz_s.rfind("/");
+  std::string l_path_s ="./";
+  if (std::string::npos != l_found_i) {
+    l_path_s = f_filenameTikz_s.substr(0, l_found_i+1);
+  }
+  const std::string l_filenameLog_s = l_filenameBase_s + ".log";
+  const std::string l_filenamePdf_s = l_filenameBase_s + ".pdf";
+  const std::string l_preamble_s = m_getPreamble_s();
+  
+  if (m_texWorker_p) {
+    // search path of waiting engine cannot be changed, tikz file is found via input path
+    std::string l_body_s;
+    l_body_s += "\\makeatletter\\def\\input@path{{" + l_path_s + "}}\\makeatother\n";
+    l_body_s += "\\begin{document}\n";
+    l_body_s += "  \\input{" + m_trimFilename_s(f_filenameTikz_s) + "}\n";
+    l_body_s += "\\end{document}\n";
+    if (m_keepTex_b) {
+      std::ofstream l_file_c;
+      l_file_c.open(l_filenameTex_s.c_str());
+      if (!l_file_c) {
+        std::stringstream l_msg_ss;
+        l_msg_ss << "Cannot write into file \"" << l_filenameTex_s << "\".";
+        throw CException(l_msg_ss.str());
+      }
+      l_file_c << l_preamble_s << l_body_s;
+    }
+    const gType_PROCESS_Result_st l_result_st = m_texWorker_p->compile_st(m_getEngine_s(), l_preamble_s, l_body_s,
+                                                                          l_filenamePdf_s, l_filenameLog_s, m_pdfTimeout_d);
+    if (l_result_st.timeout_b || (0 != l_result_st.exitCode_i)) {
+      m_throwTexError_vd(l_result_st, l_filenameTex_s, l_filenameLog_s);
+    }
+    return;
+  }
+  
+  const std::string l_scratch_s = CFile::createTempDir_s(m_scratchDir_s);
+  const std::string l_scratchBase_s = l_scratch_s + m_trimFilename_s(l_filenameBase_s);
+  try {
+    std::ofstream l_file_c;
+    l_file_c.open((l_scratchBase_s + ".tex").c_str());
+    if (l_file_c) {
+      l_file_c << l_preamble_s;
+      l_file_c << "\\begin{document}" << std::endl;
+      l_file_c << "  \\input{" << m_trimFilename_s(f_filenameTikz_s) << "}" << std::endl;
+      l_file_c << "\\end{document}" << std::endl;
+    } else {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "Cannot write into file \"" << l_scratchBase_s << ".tex\".";
+      throw CException(l_msg_ss.str());
+    }
+    l_file_c.close();
+    
+    // directory of tikz file is searched first, trailing ":" keeps default search path
+    std::vector<std::string> l_env_v;
+    const char* l_texInputs_pc = std::getenv("TEXINPUTS");
+    l_env_v.push_back("TEXINPUTS=" + l_path_s + ":" + ((NULL != l_texInputs_pc) ? l_texInputs_pc : ""));
+    
+    // engine runs twice (references of labels)
+    const std::vector<std::string> l_args_v = m_getEngineArgs_v(l_scratchBase_s + ".tex", l_scratch_s);
+    for (int l_run_i = 0; l_run_i < 2; ++l_run_i) {
+      const std::size_t l_maxOutput_i = 65536;
+      const gType_PROCESS_Result_st l_result_st = CProcess::run_st(l_args_v, m_pdfTimeout_d, l_maxOutput_i, l_env_v);
+      if (l_result_st.timeout_b || (0 != l_result_st.exitCode_i)) {
+        // log file is kept for analysis
+        if (m_fileExist_b(l_scratchBase_s + ".log")) {
+          CFile::moveFile_vd(l_scratchBase_s + ".log", l_filenameLog_s);
+        }
+        m_throwTexError_vd(l_result_st, l_filenameTex_s, l_filenameLog_s);
+      }
+    }
+    
+    if (!m_fileExist_b(l_scratchBase_s + ".pdf")) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "CTikz::createPdf(): " << l_args_v.front() << " did not create PDF file for \"" << l_filenameTex_s << "\".";
+      throw CException(l_msg_ss.str());
+    }
+    CFile::moveFile_vd(l_scratchBase_s + ".pdf", l_filenamePdf_s);
+    if (m_keepTex_b) {
+      CFile::moveFile_vd(l_scratchBase_s + ".tex", l_filenameTex_s);
+    }
+  } catch (...) {
+    CFile::removeDir_vd(l_scratch_s);
+    throw;
+  }
+  // remove aux and log file which were generated by latex
+  CFile::removeDir_vd(l_scratch_s);
+}
+
+
+// ========================================================================
+// get preamble of latex file (up to begin of document)
+// ========================================================================
+std::string CTikz::m_getPreamble_s()
+{
+  std::stringstream l_preamble_ss;
+  l_preamble_ss << "% file automatically generated by CTikz" << std::endl;
+  l_preamble_ss << "% author: " << m_author_s << std::endl;
+  l_preamble_ss << "\\documentclass[tikz,border=10pt]{standalone}" << std::endl;
+  l_preamble_ss << "\\usepackage{pgfplots}" << std::endl;
+  l_preamble_ss << "\\usepgfplotslibrary{statistics,fillbetween,groupplots}" << std::endl;
+  l_preamble_ss << "\\usepackage{tikz}" << std::endl;
+  l_preamble_ss << "\\usepackage{units}" << std::endl;
+  if (e_TIKZ_EnginePdflatex == m_engine_e) {
+    l_preamble_ss << "\\usepackage[latin9]{inputenc}" << std::endl;
+    l_preamble_ss << "\\usepackage[T1]{fontenc}" << std::endl;
+  } else { // unicode engines
+    l_preamble_ss << "\\usepackage{fontspec}" << std::endl;
+  }
+  l_preamble_ss << std::endl;
+  
+  // add user defined colors to additionLatexCommands, here some default colors
+  // user defined colors are colors which are used in the tikz file and which have to
+  // be defined when creating a pdf file with this class CTikz
+  l_preamble_ss << "\\definecolor{ctikzColorBlue}{RGB}{0,150,230}" << std::endl;
+  l_preamble_ss << "\\definecolor{ctikzColorRed}{RGB}{250,30,0}" << std::endl;
+  l_preamble_ss << "\\definecolor{ctikzColorGreen}{RGB}{100,200,60}" << std::endl;
+  l_preamble_ss << "\\definecolor{ctikzColorYellow}{RGB}{250,210,0}" << std::endl;
+  
+  // add user defined definitions, symbols etc. to additionalLatexCommands, here an example as default
+  // user defined definitions or symbols are definitions which are used in the tikz file. But they
+  // have to be definied in additionalLatexCommand to make it possible to create a pdf file with
+  // this class CTikz
+  l_preamble_ss << "\\newcommand{\\ctikzSamplingFrequency}[0]{f_\\mathrm{S}}" << std::endl;
+  l_preamble_ss << "\\newcommand{\\ctikzLineStyleExample}[0]{dashed}" << std::endl;
+  
+  l_preamble_ss << std::endl;
+  l_preamble_ss << m_additionalLatexCommands_s;
+  l_preamble_ss << std::endl;
+  return l_preamble_ss.str();
+}
+
+
+// ========================================================================
+// throw exception for failed run of TeX engine, message contains first
+// error of log file, details contain complete error and end of output
+// ========================================================================
+void CTikz::m_throwTexError_vd(const gType_PROCESS_Result_st& f_result_st,
+                               const std::string& f_filenameTex_s,
+                               const std::string& f_filenameLog_s)
+{
+  const std::string l_error_s = m_getTexError_s(f_filenameLog_s, f_result_st.output_s);
+  std::stringstream l_msg_ss;
+  l_msg_ss << "CTikz::createPdf(): " << m_getEngine_s();
+  if (f_result_st.timeout_b) {
+    l_msg_ss << " timed out after " << m_pdfTimeout_d << " s";
+  } else {
+    l_msg_ss << " failed (exit code " << f_result_st.exitCode_i << ")";
+  }
+  l_msg_ss << " for \"" << f_filenameTex_s << "\"";
+  if (m_fileExist_b(f_filenameLog_s)) {
+    l_msg_ss << ", see \"" << f_filenameLog_s << "\"";
+  }
+  l_msg_ss << ".";
+  if (!l_error_s.empty()) {
+    l_msg_ss << std::endl << l_error_s.substr(0, l_error_s.find('\n'));
+  }
+  std::stringstream l_details_ss;
+  l_details_ss << l_error_s;
+  l_details_ss << "--- end of output (" << f_result_st.outputSize_i << " bytes in total) ---" << std::endl;
+  l_details_ss << f_result_st.output_s;
+  throw CException(l_msg_ss.str(), l_details_ss.str());
+}
+
+
+// ========================================================================
+// get minimum x value
+// ========================================================================
+double CTikz::m_getMinX_d()
+{
+  double l_minVal_d;
+  if (m_useAutoRangeX_b) {
+    if (0 == m_dataSet_v.size()) {
+      throw CException("CTikz::getMinX(): data set size is 0");
+    }
+    // bounds of each data set entry are cached
+    l_minVal_d = m_getBounds_st(0).minX_d;
+    for (std::size_t l_k_i = 1; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+      if (m_getBounds_st(l_k_i).minX_d < l_minVal_d) {
+        l_minVal_d = m_getBounds_st(l_k_i).minX_d;
+      }
+    }
+    if (!std::isfinite(l_minVal_d)) { // no finite point at all
+      l_minVal_d = 0;
+    }
+  } else {
+    l_minVal_d = m_userdefinedMinX_d;
+  }
+  return l_minVal_d;
+}
+
+
+// ========================================================================
+// get maximum x value
+// ========================================================================
+double CTikz::m_getMaxX_d()
+{
+  double l_maxVal_d;
+  if (m_useAutoRangeX_b) {
+    if (0 == m_dataSet_v.size()) {
+      throw CException("CTikz::getMaxX(): data set size is 0");
+    }
+    // bounds of each data set entry are cached
+    l_maxVal_d = m_getBounds_st(0).maxX_d;
+    for (std::size_t l_k_i = 1; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+      if (m_getBounds_st(l_k_i).maxX_d > l_maxVal_d) {
+        l_maxVal_d = m_getBounds_st(l_k_i).maxX_d;
+      }
+    }
+    if (!std::isfinite(l_maxVal_d)) { // no finite point at all
+      l_maxVal_d = 1;
+    }
+  } else {
+    l_maxVal_d = m_userdefinedMaxX_d;
+  }
+  return l_maxVal_d;
+}
+
+
+// ========================================================================
+// get minimum y value
+// ========================================================================
+double CTikz::m_getMinY_d()
+{
+  double l_minVal_d;
+  if (m_useAutoRangeY_b) {
+    if (0 == m_dataSet_v.size()) {
+      throw CException("CTikz::getMinY(): data set size is 0");
+    }
+    // bounds of each data set entry are cached, data set entries of second y axis are left out
+    l_minVal_d = std::numeric_limits<double>::infinity();
+    for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+      if (!m_isSecondAxis_b(m_dataSet_v[l_k_i]) && (m_getBounds_st(l_k_i).minY_d < l_minVal_d)) {
+        l_minVal_d = m_getBounds_st(l_k_i).minY_d;
+      }
+    }
+    if (!std::isfinite(l_minVal_d)) { // no finite point at all
+      l_minVal_d = 0;
+    }
+  } else {
+    l_minVal_d = m_userdefinedMinY_d;
+  }
+  return l_minVal_d;
+}
+
+
+// ========================================================================
+// get maximum y value
+// ========================================================================
+double CTikz::m_getMaxY_d()
+{
+  double l_maxVal_d;
+  if (m_useAutoRangeY_b) {
+    if (0 == m_dataSet_v.size()) {
+      throw CException("CTikz::getMaxY(): data set size is 0");
+    }
+    // bounds of each data set entry are cached, data set entries of second y axis are left out
+    l_maxVal_d = -std::numeric_limits<double>::infinity();
+    for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+      if (!m_isSecondAxis_b(m_dataSet_v[l_k_i]) && (m_getBounds_st(l_k_i).maxY_d > l_maxVal_d)) {
+        l_maxVal_d = m_getBounds_st(l_k_i).maxY_d;
+      }
+    }
+    if (!std::isfinite(l_maxVal_d)) { // no finite point at all
+      l_maxVal_d = 1;
+    }
+  } else {
+    l_maxVal_d = m_userdefinedMaxY_d;
+  }
+  return l_maxVal_d;
+}
+
+
+// ========================================================================
+// get minimum y value of second y axis (range is always determined
+// automatically)
+// ========================================================================
+double CTikz::m_getMinY2_d()
+{
+  double l_minVal_d = std::numeric_limits<double>::infinity();
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    if (m_isSecondAxis_b(m_dataSet_v[l_k_i]) && (m_getBounds_st(l_k_i).minY_d < l_minVal_d)) {
+      l_minVal_d = m_getBounds_st(l_k_i).minY_d;
+    }
+  }
+  if (!std::isfinite(l_minVal_d)) { // no finite point at all
+    l_minVal_d = 0;
+  }
+  return l_minVal_d;
+}
+
+
+// ========================================================================
+// get maximum y value of second y axis (range is always determined
+// automatically)
+// ========================================================================
+double CTikz::m_getMaxY2_d()
+{
+  double l_maxVal_d = -std::numeric_limits<double>::infinity();
+  for (std::size_t l_k_i = 0; l_k_i < m_dataSet_v.size(); ++l_k_i) {
+    if (m_isSecondAxis_b(m_dataSet_v[l_k_i]) && (m_getBounds_st(l_k_i).maxY_d > l_maxVal_d)) {
+      l_maxVal_d = m_getBounds_st(l_k_i).maxY_d;
+    }
+  }
+  if (!std::isfinite(l_maxVal_d)) { // no finite point at all
+    l_maxVal_d = 1;
+  }
+  return l_maxVal_d;
+}
+
+
+// ========================================================================
+// create ID: random start (drawn once per process) plus counter, i.e. IDs
+// are unique within process, also for objects created concurrently, and
+// differ between processes with high probability
+// ========================================================================
+std::string CTikz::m_createId_s()
+{
+  static const uint64_t l_start_i = std::random_device()() % 100000000;
+  std::ostringstream l_tmp_ss;
+  if (!(l_tmp_ss << (l_start_i + g_idCounter_i++))) {
+    throw CException("CTikz::int2str: conversion to std::string failed.");
+  }
+  return l_tmp_ss.str();
+}
+
+
+// ========================================================================
+// trim file name
+// ========================================================================
+std::string CTikz::m_trimFilename_s(const std::string &f_filename_s)
+{
+  std::string l_retFilename_s = f_filename_s;
+  std::size_t l_pos_i = f_filename_s.rfind("/");
+  if (l_pos_i !=std::string::npos) {
+    l_retFilename_s = f_filename_s.substr(l_pos_i+1);
+  } else {
+    l_retFilename_s = f_filename_s;
+  }
+  return l_retFilename_s;
+}
+
+
+// ========================================================================
+// split file name into base and extension (only dot within name of file,
+// not within directory)
+// ========================================================================
+void CTikz::m_splitFilename_vd(const std::string& f_filename_s, std::string& f_base_s, std::string& f_extension_s)
+{
+  const std::string::size_type l_found_i = f_filename_s.rfind(".");
+  if ((std::string::npos != l_found_i) && (std::string::npos == f_filename_s.find("/", l_found_i))) {
+    f_base_s = f_filename_s.substr(0, l_found_i);
+    f_extension_s = f_filename_s.substr(l_found_i);
+  } else {
+    f_base_s = f_filename_s;
+    f_extension_s = "";
+  }
+}
+
+
+// ========================================================================
+// check if file exists
+// ========================================================================
+bool CTikz::m_fileExist_b(const std::string& f_filename_s)
+{
+  std::ifstream l_file_c(f_filename_s.c_str());
+  return l_file_c.good();
+}
+
+
+// ========================================================================
+// write raw bytes into buffer of binary state file
+// ========================================================================
+static void g_writeRaw_vd(std::string& f_buffer_s, const void* f_data_p, std::size_t f_size_i)
+{
+  f_buffer_s.append(static_cast<const char*>(f_data_p), f_size_i);
+}
+
+
+// ========================================================================
+// write 32 bit unsigned integer into buffer of binary state file
+// ========================================================================
+static void g_writeU32_vd(std::string& f_buffer_s, uint32_t f_value_i)
+{
+  g_writeRaw_vd(f_buffer_s, &f_value_i, sizeof(f_value_i));
+}
+
+
+// ========================================================================
+// write 64 bit unsigned integer into buffer of binary state file
+// ========================================================================
+static void g_writeU64_vd(std::string& f_buffer_s, uint64_t f_value_i)
+{
+  g_writeRaw_vd(f_buffer_s, &f_value_i, sizeof(f_value_i));
+}
+
+
+// ========================================================================
+// write double into buffer of binary state file
+// ========================================================================
+static void g_writeDouble_vd(std::string& f_buffer_s, double f_value_d)
+{
+  g_writeRaw_vd(f_buffer_s, &f_value_d, sizeof(f_value_d));
+}
+
+
+// ========================================================================
+// write string (length and characters) into buffer of binary state file
+// ========================================================================
+static void g_writeString_vd(std::string& f_buffer_s, const std::string& f_value_s)
+{
+  g_writeU32_vd(f_buffer_s, static_cast<uint32_t>(f_value_s.size()));
+  f_buffer_s += f_value_s;
+}
+
+
+// ========================================================================
+// write vector of strings into buffer of binary state file
+// ========================================================================
+static void g_writeStringVector_vd(std::string& f_buffer_s, const std::vector<std::string>& f_value_v)
+{
+  g_writeU32_vd(f_buffer_s, static_cast<uint32_t>(f_value_v.size()));
+  for (std::vector<std::string>::const_iterator l_value_it = f_value_v.begin(); l_value_it != f_value_v.end(); ++l_value_it) {
+    g_writeString_vd(f_buffer_s, *l_value_it);
+  }
+}
+
+
+// ========================================================================
+// pad buffer of binary state file to multiple of 8 bytes
+// ========================================================================
+static void g_writeAlign_vd(std::string& f_buffer_s)
+{
+  f_buffer_s.append((8 - f_buffer_s.size() % 8) % 8, '\0');
 }
 
 
 // ========================================================================
-// add additional settings for tikz file
+// add column to column table of binary state file, column shared by
+// several data set entries is added once
 // ========================================================================
-void CTikz::addAdditionalSettings_vd(const std::string& f_settings_s)
+static void g_addColumn_vd(const gType_TIKZ_Column_p& f_column_p,
+                           std::vector<const std::vector<double>*>& f_column_v,
+                           std::map<const std::vector<double>*, uint64_t>& f_index_m)
 {
-  m_additionalSettings_v.push_back(f_settings_s);
+  if (f_column_p && (f_index_m.end() == f_index_m.find(f_column_p.get()))) {
+    f_index_m[f_column_p.get()] = f_column_v.size();
+    f_column_v.push_back(f_column_p.get());
+  }
 }
 
 
 // ========================================================================
-// set additional commands for tikz file (old settings are cleared)
+// write index of column within column table of binary state file
 // ========================================================================
-void CTikz::setAdditionalCommands_vd(const std::string& f_command_s)
+static void g_writeColumnIndex_vd(std::string& f_buffer_s,
+                                  const gType_TIKZ_Column_p& f_column_p,
+                                  const std::map<const std::vector<double>*, uint64_t>& f_index_m)
 {
-  m_additionalsCommands_v.clear();
-  addAdditionalCommands_vd(f_command_s);
+  g_writeU64_vd(f_buffer_s, f_column_p ? f_index_m.find(f_column_p.get())->second : g_stateNoColumn_i);
 }
 
 
 // ========================================================================
-// add additional commands for tikz file
+// read raw bytes from binary state file, returns pointer into mapping
 // ========================================================================
-void CTikz::addAdditionalCommands_vd(const std::string &f_command_s)
+static const char* g_readRaw_p(gType_TIKZ_StateReader_st& f_reader_st, std::size_t f_size_i)
 {
-  m_additionalsCommands_v.push_back(f_command_s);
+  if (f_size_i > static_cast<std::size_t>(f_reader_st.end_p - f_reader_st.pos_p)) {
+    throw CException("CTikz::loadState(): file is truncated.");
+  }
+  const char* l_data_p = f_reader_st.pos_p;
+  f_reader_st.pos_p += f_size_i;
+  return l_data_p;
 }
 
 
 // ========================================================================
-// // set additianl commands which are inserted after beginning of tikz picture
-// (old settings are cleared)
+// read 32 bit unsigned integer from binary state file
 // ========================================================================
-void CTikz::setAdditionalCommandsAfterBeginTikzePicture_vd(const std::string& f_command_s)
+static uint32_t g_readU32_i(gType_TIKZ_StateReader_st& f_reader_st)
 {
-  m_additionalsCommandsAfterBeginTikzPicture_v.clear();
-  addAdditionalCommandsAfterBeginTikzePicture_vd(f_command_s);
+  uint32_t l_value_i;
+  std::memcpy(&l_value_i, g_readRaw_p(f_reader_st, sizeof(l_value_i)), sizeof(l_value_i));
+  return l_value_i;
 }
 
 
 // ========================================================================
-// // add additianl commands which are inserted after beginning of tikz picture
+// read 64 bit unsigned integer from binary state file
 // ========================================================================
-void CTikz::addAdditionalCommandsAfterBeginTikzePicture_vd(const std::string &f_command_s)
+static uint64_t g_readU64_i(gType_TIKZ_StateReader_st& f_reader_st)
 {
-  m_additionalsCommandsAfterBeginTikzPicture_v.push_back(f_command_s);
+  uint64_t l_value_i;
+  std::memcpy(&l_value_i, g_readRaw_p(f_reader_st, sizeof(l_value_i)), sizeof(l_value_i));
+  return l_value_i;
 }
 
 
 // ========================================================================
-// add node in plot
+// read double from binary state file
 // ========================================================================
-void CTikz::addNode_vd(double f_posX_d,
-                       double f_posY_d,
-                       const std::string& f_text_s,
-                       const std::string& f_color_s,
-                       const std::string& f_anchor_s,
-                       double f_rotate_d,
-                       const std::string& f_font_s)
+static double g_readDouble_d(gType_TIKZ_StateReader_st& f_reader_st)
 {
-  std::stringstream l_command_ss;
-  l_command_ss << "\\node at (axis cs:" << f_posX_d << "," << f_posY_d << ") ";
-  l_command_ss << "[text=" << f_color_s << ",anchor=" << f_anchor_s << ",rotate=";
-  l_command_ss << f_rotate_d << ",font=\\" << f_font_s << "] {" << f_text_s << "};";
-  addAdditionalCommands_vd(l_command_ss.str());
+  double l_value_d;
+  std::memcpy(&l_value_d, g_readRaw_p(f_reader_st, sizeof(l_value_d)), sizeof(l_value_d));
+  return l_value_d;
 }
 
 
 // ========================================================================
-// set on or off log scale of plot for x axis: default: on=true
+// read string from binary state file
 // ========================================================================
-void CTikz::setLogX_vd(bool f_on_b)
+static std::string g_readString_s(gType_TIKZ_StateReader_st& f_reader_st)
 {
-  m_logOnX_b = f_on_b;
+  const uint32_t l_size_i = g_readU32_i(f_reader_st);
+  return std::string(g_readRaw_p(f_reader_st, l_size_i), l_size_i);
 }
 
 
 // ========================================================================
-// set on or off log scale of plot for y axis: default: on=true
+// read vector of strings from binary state file
 // ========================================================================
-void CTikz::setLogY_vd(bool f_on_b)
+static std::vector<std::string> g_readStringVector_v(gType_TIKZ_StateReader_st& f_reader_st)
 {
-  m_logOnY_b = f_on_b;
+  const uint32_t l_size_i = g_readU32_i(f_reader_st);
+  std::vector<std::string> l_value_v;
+  for (uint32_t l_k_i = 0; l_k_i < l_size_i; ++l_k_i) {
+    l_value_v.push_back(g_readString_s(f_reader_st));
+  }
+  return l_value_v;
 }
 
 
 // ========================================================================
-// switch on grid of plot
+// skip padding of binary state file (multiple of 8 bytes from file begin)
 // ========================================================================
-void CTikz::gridOn_vd() {
-  m_gridOnX_b = true;
-  m_gridOnY_b = true;
+static void g_readAlign_vd(gType_TIKZ_StateReader_st& f_reader_st)
+{
+  const std::size_t l_offset_i = static_cast<std::size_t>(f_reader_st.pos_p - f_reader_st.begin_p);
+  g_readRaw_p(f_reader_st, (8 - l_offset_i % 8) % 8);
 }
 
 
 // ========================================================================
-// switch off grid of plot
+// read index of column and get column out of column table of binary state
+// file, null when data set entry has no such column
 // ========================================================================
-void CTikz::gridOff_vd() {
-  m_gridOnX_b = false;
-  m_gridOnY_b = false;
+static gType_TIKZ_Column_p g_readColumnIndex_p(gType_TIKZ_StateReader_st& f_reader_st,
+                                               const std::vector<gType_TIKZ_Column_p>& f_column_v)
+{
+  const uint64_t l_index_i = g_readU64_i(f_reader_st);
+  if (g_stateNoColumn_i == l_index_i) {
+    return gType_TIKZ_Column_p();
+  }
+  if (l_index_i >= f_column_v.size()) {
+    throw CException("CTikz::loadState(): invalid column.");
+  }
+  return f_column_v[l_index_i];
 }
 
 
 // ========================================================================
-// set code for second axis
+// add accumulator of other part of data to accumulator: means are weighted
+// by number of points, sum of squared deviations gets correction for
+// difference of means
 // ========================================================================
-void CTikz::setSecondAxisCode_vd(const std::string& f_secondAxisCode_s)
+static void g_mergeBin_vd(gType_TIKZ_BinAccumulator_st& f_bin_st, const gType_TIKZ_BinAccumulator_st& f_other_st)
 {
-  m_secondAxisCode_s = f_secondAxisCode_s;
+  if (0 == f_other_st.count_i) {
+    return;
+  }
+  if (0 == f_bin_st.count_i) {
+    f_bin_st = f_other_st;
+    return;
+  }
+  const double l_count_d = static_cast<double>(f_bin_st.count_i);
+  const double l_otherCount_d = static_cast<double>(f_other_st.count_i);
+  const double l_total_d = l_count_d + l_otherCount_d;
+  const double l_deltaY_d = f_other_st.meanY_d - f_bin_st.meanY_d;
+  f_bin_st.meanY_d += l_deltaY_d * l_otherCount_d / l_total_d;
+  f_bin_st.m2_d += f_other_st.m2_d + l_deltaY_d * l_deltaY_d * l_count_d * l_otherCount_d / l_total_d;
+  f_bin_st.meanX_d += (f_other_st.meanX_d - f_bin_st.meanX_d) * l_otherCount_d / l_total_d;
+  f_bin_st.count_i += f_other_st.count_i;
+  f_bin_st.minX_d = std::min(f_bin_st.minX_d, f_other_st.minX_d);
+  f_bin_st.maxX_d = std::max(f_bin_st.maxX_d, f_other_st.maxX_d);
 }
 
 
 // ========================================================================
-// set addional cammands which are only used for PDF preview generation, i.e. for latex code
-// (old latex commands are cleared)
+// quantile of data (linear interpolation between order statistics). Data is
+// partially reordered: after selection all values in front of the selected
+// index are less or equal, i.e. next (higher) quantile only needs to
+// look at values from the selected index on.
 // ========================================================================
-void CTikz::setAdditionalLatexCommands_vd(const std::string& f_additionalLatexCommands_s)
+static double g_quantile_d(std::vector<double>& f_data_v, double f_p_d, std::size_t& f_begin_i)
 {
-  m_additionalLatexCommands_s = f_additionalLatexCommands_s;
+  const double l_pos_d = (f_data_v.size() - 1) * f_p_d;
+  const std::size_t l_idx_i = static_cast<std::size_t>(l_pos_d);
+  std::nth_element(f_data_v.begin() + f_begin_i, f_data_v.begin() + l_idx_i, f_data_v.end());
+  double l_value_d = f_data_v[l_idx_i];
+  if (l_idx_i + 1 < f_data_v.size()) {
+    const double l_next_d = *std::min_element(f_data_v.begin() + l_idx_i + 1, f_data_v.end());
+    l_value_d += (l_pos_d - l_idx_i) * (l_next_d - f_data_v[l_idx_i]);
+  }
+  f_begin_i = l_idx_i;
+  return l_value_d;
 }
 
 
 // ========================================================================
-// add addional cammands which are only used for PDF preview generation, i.e. for latex code
+// decimate sorted data to minimum and maximum of each bucket. Order of
+// minimum and maximum within bucket is kept, i.e. line keeps its shape.
 // ========================================================================
-void CTikz::addAdditionalLatexCommands_vd(const std::string& f_additionalLatexCommands_s)
+static void g_decimateMinMax_vd(const std::vector<double>& f_dataX_v,
+                                CFilter& f_dataY_c,
+                                std::size_t f_buckets_i,
+                                std::vector<double>& f_decimatedX_v,
+                                std::vector<double>& f_decimatedY_v)
 {
-  m_additionalLatexCommands_s += "\n";
-  m_additionalLatexCommands_s += f_additionalLatexCommands_s;
+  const std::size_t l_size_i = f_dataX_v.size();
+  f_decimatedX_v.clear();
+  f_decimatedY_v.clear();
+  f_decimatedX_v.reserve(3 * f_buckets_i + 2);
+  f_decimatedY_v.reserve(3 * f_buckets_i + 2);
+  f_dataY_c.reset_vd();
+  f_decimatedX_v.push_back(f_dataX_v.front());
+  f_decimatedY_v.push_back(f_dataY_c.next_d());
+  for (std::size_t l_b_i = 0; l_b_i < f_buckets_i; ++l_b_i) {
+    const std::size_t l_begin_i = 1 + (l_size_i - 2) * l_b_i / f_buckets_i;
+    const std::size_t l_end_i = 1 + (l_size_i - 2) * (l_b_i + 1) / f_buckets_i;
+    if (l_begin_i >= l_end_i) {
+      continue;
+    }
+    // points which are not finite are kept as one gap per bucket
+    std::size_t l_min_i = l_end_i;
+    std::size_t l_max_i = l_end_i;
+    double l_minY_d = 0;
+    double l_maxY_d = 0;
+    bool l_gap_b = false;
+    for (std::size_t l_k_i = l_begin_i; l_k_i < l_end_i; ++l_k_i) {
+      const double l_y_d = f_dataY_c.next_d();
+      if (!std::isfinite(f_dataX_v[l_k_i]) || !std::isfinite(l_y_d)) {
+        l_gap_b = true;
+        continue;
+      }
+      if ((l_end_i == l_min_i) || (l_y_d < l_minY_d)) {
+        l_min_i = l_k_i;
+        l_minY_d = l_y_d;
+      }
+      if ((l_end_i == l_max_i) || (l_y_d > l_maxY_d)) {
+        l_max_i = l_k_i;
+        l_maxY_d = l_y_d;
+      }
+    }
+    if (l_gap_b) {
+      f_decimatedX_v.push_back(std::numeric_limits<double>::quiet_NaN());
+      f_decimatedY_v.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+    if (l_end_i == l_min_i) {
+      continue;
+    }
+    const bool l_minFirst_b = (l_min_i <= l_max_i);
+    f_decimatedX_v.push_back(f_dataX_v[l_minFirst_b ? l_min_i : l_max_i]);
+    f_decimatedY_v.push_back(l_minFirst_b ? l_minY_d : l_maxY_d);
+    if (l_max_i != l_min_i) {
+      f_decimatedX_v.push_back(f_dataX_v[l_minFirst_b ? l_max_i : l_min_i]);
+      f_decimatedY_v.push_back(l_minFirst_b ? l_maxY_d : l_minY_d);
+    }
+  }
+  f_decimatedX_v.push_back(f_dataX_v.back());
+  f_decimatedY_v.push_back(f_dataY_c.next_d());
 }
 
 
 // ========================================================================
-// set author into tikz file
+// style of plot contains marks
 // ========================================================================
-void CTikz::setAuthor_vd(const std::string& f_author_s)
+static bool g_hasMarks_b(const std::string& f_plotStyle_s)
 {
-  m_author_s = f_author_s;
+  return ((std::string::npos != f_plotStyle_s.find("mark")) &&
+          (std::string::npos == f_plotStyle_s.find("mark=none")) &&
+          (std::string::npos == f_plotStyle_s.find("no marks")));
 }
 
 
 // ========================================================================
-// set info into tikz file
+// add filters of data set entry as stages of filter
 // ========================================================================
-void CTikz::setInfo_vd(const std::string& f_info_s)
+static void g_addFilters_vd(CFilter& f_filter_c, const std::vector<gType_TIKZ_Filter_st>& f_filter_v)
 {
-  m_info_s = f_info_s;
+  for (std::vector<gType_TIKZ_Filter_st>::const_iterator l_filter_it = f_filter_v.begin(); l_filter_it != f_filter_v.end(); ++l_filter_it) {
+    const bool l_window_b = (e_TIKZ_FilterExponential != l_filter_it->filter_e);
+    if (l_window_b && !((l_filter_it->value_d >= 1) && (l_filter_it->value_d == std::floor(l_filter_it->value_d)))) {
+      std::stringstream l_msg_ss;
+      l_msg_ss << "CTikz::addFilter(): invalid window " << l_filter_it->value_d << ".";
+      throw CException(l_msg_ss.str());
+    }
+    const std::size_t l_window_i = l_window_b ? static_cast<std::size_t>(l_filter_it->value_d) : 0;
+    switch (l_filter_it->filter_e) {
+      case e_TIKZ_FilterMovingAverage:
+        f_filter_c.addMovingAverage_vd(l_window_i);
+        break;
+      case e_TIKZ_FilterExponential:
+        f_filter_c.addExponential_vd(l_filter_it->value_d);
+        break;
+      case e_TIKZ_FilterSavitzkyGolay:
+        f_filter_c.addSavitzkyGolay_vd(l_window_i, l_filter_it->order_i);
+        break;
+      default:
+        throw CException("CTikz::addFilter(): unknown filter.");
+    }
+  }
 }
 
 
 // ========================================================================
-//  create tikz file (used for histogram and non histogram)
+// write row of table. Values are rounded to multiple of quantum first
+// (adding zero avoids "-0"), default format (6 digits) is equal to %g.
 // ========================================================================
-void CTikz::m_createTikzFile_vd(const std::string& f_filename_s,
-                                bool f_createHist_b,
-                                int f_bins_i /* = 0 */,
-                                double f_dataMin_d /* = 0 */ ,
-                                double f_dataMax_d /* = 0 */)
+static int g_formatRow_i(char* f_buffer_pc,
+                         std::size_t f_size_i,
+                         double f_x_d,
+                         double f_y_d,
+                         const gType_TIKZ_NumberFormat_st& f_formatX_st,
+                         const gType_TIKZ_NumberFormat_st& f_formatY_st)
 {
-  if (m_fileExist_b(f_filename_s)) {
-    std::stringstream l_msg_ss;
-    l_msg_ss << "File \"" << f_filename_s << "\" already exists.";
-    throw CException(l_msg_ss.str());
-  }
-  std::stringstream l_tikz_ss;
-  l_tikz_ss << "% file automatically generated by CTikz" << std::endl;
-  l_tikz_ss << "% author: " << m_author_s << std::endl;
-  l_tikz_ss << "% " << std::endl;
-  l_tikz_ss << "% info: " << m_info_s << std::endl;
-  l_tikz_ss << "% " << std::endl;
-  l_tikz_ss << "\\begin{tikzpicture}" << std::endl;
-  for (std::vector<std::string>::iterator l_cmd_it = m_additionalsCommandsAfterBeginTikzPicture_v.begin(); l_cmd_it != m_additionalsCommandsAfterBeginTikzPicture_v.end(); ++l_cmd_it) {
-    l_tikz_ss << *l_cmd_it << std::endl;
-  }
-  l_tikz_ss << "\\begin{axis}[" << std::endl;
-  l_tikz_ss << ">=latex," << std::endl;
-  l_tikz_ss << "width=" << m_width_s << "," << std::endl;
-  l_tikz_ss << "height=" << m_height_s << "," << std::endl;
-  l_tikz_ss << "scale only axis," << std::endl;
-  l_tikz_ss << "xmin=" << m_getMinX_d() << "," << std::endl;
-  l_tikz_ss << "xmax=" << m_getMaxX_d() << "," << std::endl;
-  l_tikz_ss << "xlabel={" << m_xLabel_s << "}," << std::endl;
-  if (m_gridOnX_b) {
-    l_tikz_ss << "xmajorgrids," << std::endl;
-  }
-  if (m_logOnX_b) {
-    l_tikz_ss << "xmode=log,log basis x=10," << std::endl;
+  double l_x_d = f_x_d;
+  double l_y_d = f_y_d;
+  if (f_formatX_st.quantum_d > 0) {
+    l_x_d = std::round(f_x_d / f_formatX_st.quantum_d) * f_formatX_st.quantum_d + 0.0;
   }
-  if (!f_createHist_b) { // normal mode
-    l_tikz_ss << "ymin=" << m_getMinY_d() << "," << std::endl;
-    l_tikz_ss << "ymax=" << m_getMaxY_d() << "," << std::endl;
+  if (f_formatY_st.quantum_d > 0) {
+    l_y_d = std::round(f_y_d / f_formatY_st.quantum_d) * f_formatY_st.quantum_d + 0.0;
   }
-  l_tikz_ss << "ylabel={" << m_yLabel_s << "}," << std::endl;
-  if (f_createHist_b) { // histogram mode
-    l_tikz_ss << "ymin=0," << std::endl;
-    l_tikz_ss << "ybar," << std::endl;
-  }
-  if (m_gridOnY_b) {
-    l_tikz_ss << "ymajorgrids," << std::endl;
-  }
-  if (m_logOnY_b) {
-    l_tikz_ss << "ymode=log,log basis y=10," << std::endl;
+  return std::snprintf(f_buffer_pc, f_size_i, "%.*g\t%.*g\\\\\n", f_formatX_st.digits_i, l_x_d, f_formatY_st.digits_i, l_y_d);
+}
+
+
+// ========================================================================
+// write value rounded to multiple of quantum (adding zero avoids "-0").
+// Values which are not finite are written as gap ("nan").
+// ========================================================================
+static int g_formatValue_i(char* f_buffer_pc,
+                           std::size_t f_size_i,
+                           double f_value_d,
+                           const gType_TIKZ_NumberFormat_st& f_format_st)
+{
+  if (!std::isfinite(f_value_d)) {
+    return std::snprintf(f_buffer_pc, f_size_i, "nan");
   }
-  l_tikz_ss << "title={" << m_title_s << "}," << std::endl;
-  for (std::vector<std::string>::const_iterator l_settings_it = m_additionalSettings_v.begin();
-       l_settings_it != m_additionalSettings_v.end(); ++l_settings_it) {
-    l_tikz_ss << *l_settings_it << "," << std::endl;
+  double l_value_d = f_value_d;
+  if (f_format_st.quantum_d > 0) {
+    l_value_d = std::round(f_value_d / f_format_st.quantum_d) * f_format_st.quantum_d + 0.0;
   }
-  l_tikz_ss << "legend style={" << m_legendStyle_s << "}" << std::endl;
-  l_tikz_ss << "]" << std::endl;
-  if ("" != m_legendTitle_s) {
-    l_tikz_ss << "\\addlegendimage{empty legend}" << std::endl;
+  return std::snprintf(f_buffer_pc, f_size_i, "%.*g", f_format_st.digits_i, l_value_d);
+}
+
+
+// ========================================================================
+// data set entry is written as line plot with own table, i.e. it is neither
+// raster graphics nor envelope nor plot with error bars nor split into chunks
+// ========================================================================
+static bool g_isLineTable_b(const gType_TIKZ_DataSet_st& f_dataSet_st, std::size_t f_chunkSize_i)
+{
+  return !f_dataSet_st.raster_b && !f_dataSet_st.lower_p && !f_dataSet_st.error_p &&
+    ((0 == f_chunkSize_i) || (f_dataSet_st.y_p->size() <= f_chunkSize_i));
+}
+
+
+// ========================================================================
+// get x column of data set entry. x values of uniform grid are computed
+// into new column (not kept by data set entry).
+// ========================================================================
+static gType_TIKZ_Column_p g_getColumnX_p(const gType_TIKZ_DataSet_st& f_dataSet_st)
+{
+  if (f_dataSet_st.x_p) {
+    return f_dataSet_st.x_p;
   }
-  bool l_legendTitleSet_b = false;
-  int l_legendIdx_i = 0;
-  int l_IdCtr_i = 0;
-  for (std::vector<gType_TIKZ_DataSetEntry_st>::const_iterator l_dataSetEntry_it = m_dataSet_v.begin(); l_dataSetEntry_it != m_dataSet_v.end(); ++l_dataSetEntry_it) {
-    if (!f_createHist_b) { // normal mode
-      l_tikz_ss << "\\addplot [color=" << l_dataSetEntry_it->color_s << ",";
-    } else { // histogram mode
-      l_tikz_ss << "\\addplot+ [color=" << l_dataSetEntry_it->color_s << ",";
-      l_tikz_ss << " ,hist={" << std::endl;
-      l_tikz_ss << "    density," << std::endl;
-      l_tikz_ss << "    bins=" << f_bins_i << "," << std::endl;
-      l_tikz_ss << "    data min=" << f_dataMin_d << "," << std::endl;
-      l_tikz_ss << "    data max=" << f_dataMax_d << std::endl;
-      l_tikz_ss << " },";
-    }
-    l_tikz_ss << l_dataSetEntry_it->plotStyle_s << "]" << std::endl;
-    if ("" != l_dataSetEntry_it->comment_s) {
-      l_tikz_ss << "% " << l_dataSetEntry_it->comment_s << std::endl;
-    }
-    l_tikz_ss << "  table[row sep=crcr]{%" << std::endl;
-    for (std::vector<std::pair<double, double> >::const_iterator l_data_it = l_dataSetEntry_it->data_v.begin();
-         l_data_it != l_dataSetEntry_it->data_v.end();
-         ++l_data_it) {
-      l_tikz_ss << l_data_it->first << "\t" << l_data_it->second << "\\\\" << std::endl;
-    }
-    l_tikz_ss << "};" << std::endl;
-    l_tikz_ss << "\\label{addPlotLabel_" << m_id_s << "_" << l_IdCtr_i++ << "}" << std::endl;
-    if ("" != m_legendTitle_s && !l_legendTitleSet_b) {
-      l_tikz_ss << "\\addlegendentry{\\hspace{-.6cm}" << m_legendTitle_s << "};" << std::endl;
-      l_legendTitleSet_b = true;
-    }
-    if (l_legendIdx_i < m_legend_v.size()) {
-      l_tikz_ss << "\\addlegendentry{" << m_legend_v.at(l_legendIdx_i) << "};" << std::endl;
-      ++l_legendIdx_i;
+  std::shared_ptr<std::vector<double> > l_dataX_p = std::make_shared<std::vector<double> >(f_dataSet_st.y_p->size());
+  std::vector<double>& l_dataX_v = *l_dataX_p;
+  CParallel::for_vd(l_dataX_v.size(), [&](std::size_t f_begin_i, std::size_t f_end_i, unsigned int) {
+    for (std::size_t l_k_i = f_begin_i; l_k_i < f_end_i; ++l_k_i) {
+      l_dataX_v[l_k_i] = f_dataSet_st.startX_d + l_k_i * f_dataSet_st.stepX_d;
     }
-  }
-  
-  l_tikz_ss << std::endl;
-  for (std::vector<std::string>::iterator l_commands_it = m_additionalsCommands_v.begin(); l_commands_it != m_additionalsCommands_v.end(); ++l_commands_it) {
-    l_tikz_ss << *l_commands_it << std::endl;
-  }
-  l_tikz_ss << std::endl;
-  l_tikz_ss << "\\end{axis}" << std::endl;
-  // insert second axis
-  l_tikz_ss << m_secondAxisCode_s;
-  l_tikz_ss << "\\end{tikzpicture}%" << std::endl;
-  
-  std::ofstream l_file_c;
-  l_file_c.open(f_filename_s.c_str());
-  if (l_file_c) {
-    l_file_c << l_tikz_ss.str();
-  } else {
-    std::stringstream l_msg_ss;
-    l_msg_ss << "Cannot write into file \"" << f_filename_s << "\".";
-    throw CException(l_msg_ss.str());
-  }
-  l_file_c.close();
+  });
+  return l_dataX_p;
 }
 
 
 // ========================================================================
-// create PDF file
+// get column of filtered y values, filter stages run once over all values
 // ========================================================================
-void CTikz::m_createPdf_vd(const std::string& f_filenameTikz_s)
+static gType_TIKZ_Column_p g_getColumnY_p(const gType_TIKZ_DataSet_st& f_dataSet_st)
 {
-  std::string l_filenameBase_s = f_filenameTikz_s;
-  std::string::size_type l_found_i = l_filenameBase_s.rfind(".");
-  if (std::string::npos != l_found_i) {
-    l_filenameBase_s = l_filenameBase_s.substr(0, l_found_i);
-  }
-  std::string l_filenameTex_s = l_filenameBase_s;
-  l_filenameTex_s += ".tex";
-  if (m_fileExist_b(l_filenameTex_s)) {
-    std::stringstream l_msg_ss;
-    l_msg_ss << "File \"" << l_filenameTex_s << "\" already exists.";
-    throw CException(l_msg_ss.str());
-  }
-  // determine directory/path
-  l_found_i = f_filenameTikz_s.rfind("/");
-  std::string l_path_s ="./";
-  if (std::string::npos != l_found_i) {
-    l_path_s = f_filenameTikz_s.substr(0, l_found_i+1);
-  }
-  
-  std::ofstream l_file_c;
-  l_file_c.open(l_filenameTex_s.c_str());
-  if (l_file_c) {
-    l_file_c << "% file automatically generated by CTikz" << std::endl;
-    l_file_c << "% author: " << m_author_s << std::endl;
-    l_file_c << "\\documentclass[tikz,border=10pt]{standalone}" << std::endl;
-    l_file_c << "\\usepackage{pgfplots}" << std::endl;
-    l_file_c << "\\usepackage{tikz}" << std::endl;
-    l_file_c << "\\usepackage{units}" << std::endl;
-    l_file_c << "\\usepackage[latin9]{inputenc}" << std::endl;
-    l_file_c << "\\usepackage[T1]{fontenc}" << std::endl;
-    l_file_c << std::endl;
-    
-    // add user defined colors to additionLatexCommands, here some default colors
-    // user defined colors are colors which are used in the tikz file and which have to
-    // be defined when creating a pdf file with this class CTikz
-    l_file_c << "\\definecolor{ctikzColorBlue}{RGB}{0,150,230}" << std::endl;
-    l_file_c << "\\definecolor{ctikzColorRed}{RGB}{250,30,0}" << std::endl;
-    l_file_c << "\\definecolor{ctikzColorGreen}{RGB}{100,200,60}" << std::endl;
-    l_file_c << "\\definecolor{ctikzColorYellow}{RGB}{250,210,0}" << std::endl;
-    
-    // add user defined definitions, symbols etc. to additionalLatexCommands, here an example as default
-    // user defined definitions or symbols are definitions which are used in the tikz file. But they
-    // have to be definied in additionalLatexCommand to make it possible to create a pdf file with
-    // this class CTikz
-    l_file_c << "\\newcommand{\\ctikzSamplingFrequency}[0]{f_\\mathrm{S}}" << std::endl;
-    l_file_c << "\\newcommand{\\ctikzLineStyleExample}[0]{dashed}" << std::endl;
-    
-    l_file_c << std::endl;
-    l_file_c << m_additionalLatexCommands_s;
-    l_file_c << std::endl;
-    l_file_c << "\\begin{document}" << std::endl;
-    l_file_c << "  \\input{" << m_trimFilename_s(f_filenameTikz_s) << "}" << std::endl;
-    l_file_c << "\\end{document}" << std::endl;
-  } else {
-    std::stringstream l_msg_ss;
-    l_msg_ss << "Cannot write into file \"" << l_filenameTex_s << "\".";
-    throw CException(l_msg_ss.str());
+  if (f_dataSet_st.filter_v.empty()) {
+    return f_dataSet_st.y_p;
   }
-  l_file_c.close();
-  
-  std::stringstream l_Cmd_ss;
-  l_Cmd_ss << "pdflatex ";
-  l_Cmd_ss << "--output-directory " << l_path_s;
-  l_Cmd_ss << " " << m_trimFilename_s(l_filenameTex_s);
-  l_Cmd_ss << " >/dev/null;";
-  l_Cmd_ss << "pdflatex ";
-  l_Cmd_ss << "--output-directory " << l_path_s;
-  l_Cmd_ss << " " << m_trimFilename_s(l_filenameTex_s);
-  l_Cmd_ss << " >/dev/null";
-  std::system(l_Cmd_ss.str().c_str());
-  
-  // remove aux file which was generated by latex
-  std::string l_filenameAux_s = l_filenameBase_s;
-  l_filenameAux_s += ".aux";
-  std::remove(l_filenameAux_s.c_str());
-  
-  // remove log file which was generated by latex
-  std::string l_filenameLog_s = l_filenameBase_s;
-  l_filenameLog_s += ".log";
-  std::remove(l_filenameLog_s.c_str());
+  CFilter l_filter_c(*f_dataSet_st.y_p);
+  g_addFilters_vd(l_filter_c, f_dataSet_st.filter_v);
+  std::shared_ptr<std::vector<double> > l_dataY_p = std::make_shared<std::vector<double> >();
+  l_filter_c.getFiltered_vd(*l_dataY_p);
+  return l_dataY_p;
 }
 
 
 // ========================================================================
-// get minimum x value
+// write row with y value only
 // ========================================================================
-double CTikz::m_getMinX_d()
+static int g_formatRowY_i(char* f_buffer_pc,
+                          std::size_t f_size_i,
+                          double f_y_d,
+                          const gType_TIKZ_NumberFormat_st& f_formatY_st)
 {
-  double l_minVal_d;
-  if (m_useAutoRangeX_b) {
-    if (0 == m_dataSet_v.size()) {
-      throw CException("CTikz::getMinX(): data set size is 0");
-    }
-    if (0 == m_dataSet_v.begin()->data_v.size()) {
-      throw CException("CTikz::getMinX(): data size is 0.");
-    }
-    l_minVal_d = m_dataSet_v.begin()->data_v.begin()->first;
-    for (std::vector<gType_TIKZ_DataSetEntry_st>::const_iterator l_dataSetEntry_it = m_dataSet_v.begin();
-         l_dataSetEntry_it != m_dataSet_v.end();
-         ++l_dataSetEntry_it) {
-      for (std::vector<std::pair<double, double> >::const_iterator l_data_it = l_dataSetEntry_it->data_v.begin();
-           l_data_it != l_dataSetEntry_it->data_v.end();
-           ++l_data_it) {
-        if (l_data_it->first < l_minVal_d) {
-          l_minVal_d = l_data_it->first;
-        }
-      }
-    }
-  } else {
-    l_minVal_d = m_userdefinedMinX_d;
-  }
-  return l_minVal_d;
+  const int l_len_i = g_formatValue_i(f_buffer_pc, f_size_i, f_y_d, f_formatY_st);
+  return l_len_i + std::snprintf(f_buffer_pc + l_len_i, f_size_i - l_len_i, "\\\\\n");
 }
 
 
 // ========================================================================
-// get maximum x value
+// write row with x value, y value and error of y value
 // ========================================================================
-double CTikz::m_getMaxX_d()
+static int g_formatRowError_i(char* f_buffer_pc,
+                              std::size_t f_size_i,
+                              double f_x_d,
+                              double f_y_d,
+                              double f_error_d,
+                              const gType_TIKZ_NumberFormat_st& f_formatX_st,
+                              const gType_TIKZ_NumberFormat_st& f_formatY_st)
 {
-  double l_maxVal_d;
-  if (m_useAutoRangeX_b) {
-    if (0 == m_dataSet_v.size()) {
-      throw CException("CTikz::getMaxX(): data set size is 0");
-    }
-    if (0 == m_dataSet_v.begin()->data_v.size()) {
-      throw CException("CTikz::getMaxX(): data size is 0.");
-    }
-    l_maxVal_d = m_dataSet_v.begin()->data_v.begin()->first;
-    for (std::vector<gType_TIKZ_DataSetEntry_st>::const_iterator l_dataSetEntry_it = m_dataSet_v.begin();
-         l_dataSetEntry_it != m_dataSet_v.end();
-         ++l_dataSetEntry_it) {
-      for (std::vector<std::pair<double, double> >::const_iterator l_data_it = l_dataSetEntry_it->data_v.begin();
-           l_data_it != l_dataSetEntry_it->data_v.end();
-           ++l_data_it) {
-        if (l_data_it->first > l_maxVal_d) {
-          l_maxVal_d = l_data_it->first;
-        }
-      }
-    }
-  } else {
-    l_maxVal_d = m_userdefinedMaxX_d;
-  }
-  return l_maxVal_d;
+  int l_len_i = g_formatValue_i(f_buffer_pc, f_size_i, f_x_d, f_formatX_st);
+  f_buffer_pc[l_len_i++] = '\t';
+  l_len_i += g_formatValue_i(f_buffer_pc + l_len_i, f_size_i - l_len_i, f_y_d, f_formatY_st);
+  f_buffer_pc[l_len_i++] = '\t';
+  l_len_i += g_formatValue_i(f_buffer_pc + l_len_i, f_size_i - l_len_i, f_error_d, f_formatY_st);
+  return l_len_i + std::snprintf(f_buffer_pc + l_len_i, f_size_i - l_len_i, "\\\\\n");
 }
 
 
 // ========================================================================
-// get minimum y value
+// get options of table. x values of uniform grid are computed from index of
+// row (coordindex starts at zero in each addplot).
 // ========================================================================
-double CTikz::m_getMinY_d()
+static std::string g_getTableOptions_s(const gType_TIKZ_DataSetCache_st& f_cache_st, std::size_t f_firstRow_i)
 {
-  double l_minVal_d;
-  if (m_useAutoRangeY_b) {
-    if (0 == m_dataSet_v.size()) {
-      throw CException("CTikz::getMinY(): data set size is 0");
-    }
-    if (0 == m_dataSet_v.begin()->data_v.size()) {
-      throw CException("CTikz::getMinY(): data size is 0.");
-    }
-    l_minVal_d = m_dataSet_v.begin()->data_v.begin()->second;
-    for (std::vector<gType_TIKZ_DataSetEntry_st>::const_iterator l_dataSetEntry_it = m_dataSet_v.begin();
-         l_dataSetEntry_it != m_dataSet_v.end();
-         ++l_dataSetEntry_it) {
-      for (std::vector<std::pair<double, double> >::const_iterator l_data_it = l_dataSetEntry_it->data_v.begin();
-           l_data_it != l_dataSetEntry_it->data_v.end();
-           ++l_data_it) {
-        if (l_data_it->second < l_minVal_d) {
-          l_minVal_d = l_data_it->second;
-        }
-      }
-    }
-  } else {
-    l_minVal_d = m_userdefinedMinY_d;
+  if (!f_cache_st.uniformX_b) {
+    return "row sep=crcr";
   }
-  return l_minVal_d;
+  const double l_startX_d = f_cache_st.startX_d + f_firstRow_i * f_cache_st.stepX_d;
+  return "row sep=crcr," + g_getUniformExpr_s(l_startX_d, f_cache_st.stepX_d) + ",y index=0";
 }
 
 
 // ========================================================================
-// get maximum y value
+// get x expression of uniform grid
 // ========================================================================
-double CTikz::m_getMaxY_d() {
-  double l_maxVal_d;
-  if (m_useAutoRangeY_b) {
-    if (0 == m_dataSet_v.size()) {
-      throw CException("CTikz::getMaxY(): data set size is 0");
-    }
-    if (0 == m_dataSet_v.begin()->data_v.size()) {
-      throw CException("CTikz::getMaxY(): data size is 0.");
-    }
-    l_maxVal_d = m_dataSet_v.begin()->data_v.begin()->second;
-    for (std::vector<gType_TIKZ_DataSetEntry_st>::const_iterator l_dataSetEntry_it = m_dataSet_v.begin();
-         l_dataSetEntry_it != m_dataSet_v.end();
-         ++l_dataSetEntry_it) {
-      for (std::vector<std::pair<double, double> >::const_iterator l_data_it = l_dataSetEntry_it->data_v.begin();
-           l_data_it != l_dataSetEntry_it->data_v.end();
-           ++l_data_it) {
-        if (l_data_it->second > l_maxVal_d) {
-          l_maxVal_d = l_data_it->second;
-        }
-      }
-    }
-  } else {
-    l_maxVal_d = m_userdefinedMaxY_d;
-  }
-  return l_maxVal_d;
+static std::string g_getUniformExpr_s(double f_startX_d, double f_stepX_d)
+{
+  return "x expr=\\coordindex*" + g_formatExact_s(f_stepX_d) + ((f_startX_d < 0) ? "" : "+") + g_formatExact_s(f_startX_d);
 }
 
 
 // ========================================================================
-// create ID
+// write value with 15 significant digits, 17 digits if value is not read
+// back exactly
 // ========================================================================
-std::string CTikz::m_createId_s()
+static std::string g_formatExact_s(double f_value_d)
 {
-  srand(unsigned(time(0)));
-  std::ostringstream l_tmp_ss;
-  if (!(l_tmp_ss << (rand() % 100000000))) {
-    throw CException("CTikz::int2str: conversion to std::string failed.");
+  char l_buffer_pc[32];
+  std::snprintf(l_buffer_pc, sizeof(l_buffer_pc), "%.15g", f_value_d);
+  if (std::strtod(l_buffer_pc, NULL) != f_value_d) {
+    std::snprintf(l_buffer_pc, sizeof(l_buffer_pc), "%.17g", f_value_d);
   }
-  return l_tmp_ss.str();
+  return l_buffer_pc;
 }
 
 
 // ========================================================================
-// trim file name
+// write value with default format of std::ostream
 // ========================================================================
-std::string CTikz::m_trimFilename_s(const std::string &f_filename_s)
+static std::string g_toString_s(double f_value_d)
 {
-  std::string l_retFilename_s = f_filename_s;
-  std::size_t l_pos_i = f_filename_s.rfind("/");
-  if (l_pos_i !=std::string::npos) {
-    l_retFilename_s = f_filename_s.substr(l_pos_i+1);
-  } else {
-    l_retFilename_s = f_filename_s;
+  char l_buffer_pc[32];
+  const int l_len_i = std::snprintf(l_buffer_pc, sizeof(l_buffer_pc), "%g", f_value_d);
+  return std::string(l_buffer_pc, l_len_i);
+}
+
+
+// ========================================================================
+// get number of timestamps per second
+// ========================================================================
+static int64_t g_getUnitsPerSecond_i(gType_TIKZ_TimeUnit_e f_unit_e)
+{
+  switch (f_unit_e) {
+    case e_TIKZ_TimeUnitMilliseconds:
+      return 1000;
+    case e_TIKZ_TimeUnitMicroseconds:
+      return 1000000;
+    case e_TIKZ_TimeUnitNanoseconds:
+      return 1000000000;
+    case e_TIKZ_TimeUnitSeconds:
+    default:
+      return 1;
   }
-  return l_retFilename_s;
 }
 
 
 // ========================================================================
-// check if file exists
+// integer division rounding towards negative infinity (divisor is positive)
 // ========================================================================
-bool CTikz::m_fileExist_b(const std::string& f_filename_s)
+static int64_t g_floorDiv_i(int64_t f_value_i, int64_t f_divisor_i)
 {
-  std::ifstream l_file_c(f_filename_s.c_str());
-  return l_file_c.good();
+  int64_t l_quotient_i = f_value_i / f_divisor_i;
+  if ((f_value_i % f_divisor_i) < 0) {
+    --l_quotient_i;
+  }
+  return l_quotient_i;
 }
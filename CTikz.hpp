@@ -8,6 +8,14 @@
  * @details Class to create Tikz files (Tikz ist kein Zeichenprogram) out of C array or data vector.
  *   Pdf preview and latex code can also be generated.
  *
+ *   Values which are not finite (NaN, Inf) are gaps: plots are interrupted at gaps and
+ *   ranges of axes are determined by finite points only.
+ *
+ *   Threads: different objects can be used concurrently, also copies which share data with
+ *   each other (shared data is never modified). One object must not be used by several
+ *   threads at the same time. Each object gets a unique ID (labels in tikz code), see also
+ *   CTikzBatch to create many files with a pool of worker threads.
+ *
  */
 
 
@@ -18,6 +26,12 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <memory>
+#include <stdint.h>
+#include "CProcess.hpp"
+
+class CTexWorker;
+class CPyramid;
 
 typedef struct C_TIKZ_DataSetEntry_st
 {
@@ -27,16 +41,212 @@ typedef struct C_TIKZ_DataSetEntry_st
   std::string plotStyle_s;
 } gType_TIKZ_DataSetEntry_st;
 
+// format of coordinates of one axis in tables
+typedef struct C_TIKZ_NumberFormat_st
+{
+  int digits_i; // significant digits
+  double quantum_d; // coordinates are rounded to multiple of quantum (0: no rounding)
+} gType_TIKZ_NumberFormat_st;
+
+// cached render results of one data set entry. Serialized table and bounds
+// are only recomputed when the data set entry is dirty. Once created the
+// cache is immutable, i.e. it is shared between copies of a CTikz object.
+typedef struct C_TIKZ_DataSetCache_st
+{
+  std::string table_s; // serialized table rows
+  std::string lowerTable_s; // serialized table rows of lower bound of envelope
+  std::string upperTable_s; // serialized table rows of upper bound of envelope
+  double minX_d; // minimum x value of data set entry (infinity when there is no finite point)
+  double maxX_d; // maximum x value of data set entry
+  double minY_d; // minimum y value of data set entry (envelope included)
+  double maxY_d; // maximum y value of data set entry (envelope included)
+  bool table_b; // tables are created (not for raster graphics or before range of axes is known)
+  std::size_t gaps_i; // number of gaps (points with value which is not finite) between finite points
+  bool uniformX_b; // x values are uniform grid (exactly), tables contain only y values (x expr of pgfplots)
+  double startX_d; // first x value of uniform grid
+  double stepX_d; // step of uniform grid
+  gType_TIKZ_NumberFormat_st formatX_st; // format of x values in tables
+  gType_TIKZ_NumberFormat_st formatY_st; // format of y values in tables
+} gType_TIKZ_DataSetCache_st;
+
+// column of data values. Columns are immutable and reference counted, i.e.
+// copies of a CTikz object share their data (copy on write: data is never
+// modified in place, a changed column is always a new column).
+typedef std::shared_ptr<const std::vector<double> > gType_TIKZ_Column_p;
+
+// filter of y values of data set entry (equidistant samples)
+typedef enum C_TIKZ_Filter_e
+{
+  e_TIKZ_FilterMovingAverage, // centered moving average, value: window (odd number of samples)
+  e_TIKZ_FilterExponential, // exponential smoothing, value: smoothing factor (0, 1]
+  e_TIKZ_FilterSavitzkyGolay // Savitzky-Golay, value: window (odd number of samples), order of polynomial
+} gType_TIKZ_Filter_e;
+
+// filter stage of data set entry
+typedef struct C_TIKZ_Filter_st
+{
+  gType_TIKZ_Filter_e filter_e;
+  double value_d; // window or smoothing factor
+  unsigned int order_i; // order of polynomial (Savitzky-Golay)
+} gType_TIKZ_Filter_st;
+
+// internal representation of data set entry
+typedef struct C_TIKZ_DataSet_st
+{
+  gType_TIKZ_Column_p x_p; // x values, null for uniform grid (x values are not stored)
+  double startX_d; // first x value of uniform grid (only when x_p is null)
+  double stepX_d; // step of uniform grid (only when x_p is null)
+  gType_TIKZ_Column_p y_p; // y values
+  gType_TIKZ_Column_p lower_p; // lower bound of envelope, null when data set entry has no envelope
+  gType_TIKZ_Column_p upper_p; // upper bound of envelope, null when data set entry has no envelope
+  gType_TIKZ_Column_p error_p; // error of y values (symmetric error bars), null when data set entry has no error bars
+  std::vector<gType_TIKZ_Filter_st> filter_v; // filters applied in order to y values while data is written
+  std::string comment_s;
+  std::string color_s;
+  std::string plotStyle_s;
+  bool raster_b; // data set entry is rendered as raster graphics
+  double rasterMarkSize_d; // radius of marks in raster graphics in pt
+  bool secondAxis_b; // data set entry is plotted on second y axis (right side of plot)
+  std::shared_ptr<const gType_TIKZ_DataSetCache_st> cache_p; // render cache, null when dirty
+  std::shared_ptr<const CPyramid> pyramid_p; // min/max pyramid of data for windows of x axis, null until used
+} gType_TIKZ_DataSet_st;
+
+// render cache of table of data set entries with common x column (one column per data set entry)
+typedef struct C_TIKZ_SharedTable_st
+{
+  gType_TIKZ_Column_p x_p; // common x values
+  bool secondAxis_b; // table of data set entries of second y axis
+  std::vector<gType_TIKZ_Column_p> y_v; // y values of data set entries in order of columns
+  gType_TIKZ_NumberFormat_st formatX_st; // format of x values in table
+  gType_TIKZ_NumberFormat_st formatY_st; // format of y values in table
+  std::string table_s; // rows of table
+} gType_TIKZ_SharedTable_st;
+
+// center line of envelope
+typedef enum C_TIKZ_Center_e
+{
+  e_TIKZ_CenterMean,
+  e_TIKZ_CenterMedian
+} gType_TIKZ_Center_e;
+
+// bins of x values of binned mean
+typedef enum C_TIKZ_Binning_e
+{
+  e_TIKZ_BinningFixed, // bins of equal width between minimum and maximum x value
+  e_TIKZ_BinningQuantile // bins with equal number of points (quantiles of x values)
+} gType_TIKZ_Binning_e;
+
+// statistics of y values of points of one bin
+typedef struct C_TIKZ_Bin_st
+{
+  double minX_d; // minimum x value of points of bin
+  double maxX_d; // maximum x value of points of bin
+  uint64_t count_i; // number of points
+  double meanX_d; // mean of x values
+  double mean_d; // mean of y values
+  double stddev_d; // standard deviation of y values (sample, 0 for single point)
+  double stderr_d; // standard error of mean of y values
+} gType_TIKZ_Bin_st;
+
+// handling of graphics exceeding TeX cost budget
+typedef enum C_TIKZ_Budget_e
+{
+  e_TIKZ_BudgetOff, // no budget
+  e_TIKZ_BudgetReject, // graphics exceeding budget is rejected with exception
+  e_TIKZ_BudgetReduce // data is decimated or rasterized until graphics fits into budget
+} gType_TIKZ_Budget_e;
+
+// TeX engine used to create PDF file
+typedef enum C_TIKZ_Engine_e
+{
+  e_TIKZ_EnginePdflatex, // fixed memory pools
+  e_TIKZ_EngineLualatex, // dynamic memory, handles large graphics
+  e_TIKZ_EngineXelatex
+} gType_TIKZ_Engine_e;
+
+// precision of coordinates written into tables
+typedef enum C_TIKZ_Precision_e
+{
+  e_TIKZ_PrecisionDefault, // 6 significant digits (%g)
+  e_TIKZ_PrecisionDigits, // fixed number of significant digits
+  e_TIKZ_PrecisionAxis // rounded to resolution of axis (range, size of plot and dots per inch)
+} gType_TIKZ_Precision_e;
+
+// unit of timestamps of time axis
+typedef enum C_TIKZ_TimeUnit_e
+{
+  e_TIKZ_TimeUnitSeconds,
+  e_TIKZ_TimeUnitMilliseconds,
+  e_TIKZ_TimeUnitMicroseconds,
+  e_TIKZ_TimeUnitNanoseconds
+} gType_TIKZ_TimeUnit_e;
+
+// type of graphics created out of data set
+typedef enum C_TIKZ_PlotType_e
+{
+  e_TIKZ_PlotTypeLine, // plot of each data set entry
+  e_TIKZ_PlotTypeHist, // histogram of each data set entry (binning by pgfplots)
+  e_TIKZ_PlotTypeHist2d, // 2D histogram (heatmap) of all data set entries (binning by CTikz)
+  e_TIKZ_PlotTypeBox // box plot of y values of each data set entry (quantiles by CTikz)
+} gType_TIKZ_PlotType_e;
+
+// type and parameters of graphics
+typedef struct C_TIKZ_PlotParam_st
+{
+  gType_TIKZ_PlotType_e type_e; // type of graphics
+  int bins_i; // number of bins (histogram) or number of bins in x direction (2D histogram)
+  int binsY_i; // number of bins in y direction (2D histogram)
+  double dataMin_d; // minimum value of histogram
+  double dataMax_d; // maximum value of histogram
+  bool raster_b; // 2D histogram is written as raster graphics instead of matrix plot table
+  int maxOutliers_i; // maximum number of outliers written per box plot
+  bool groupPanel_b; // axis is panel of group plot (see CTikzGroup)
+  bool sharedX_b; // range of x axis is set by group plot
+  bool sharedY_b; // range of y axis is set by group plot
+} gType_TIKZ_PlotParam_st;
+
+// settings of user which are replaced while log axes are computed in C++
+typedef struct C_TIKZ_LogSettings_st
+{
+  std::vector<gType_TIKZ_DataSet_st> dataSet_v; // data set entries of user
+  std::vector<gType_TIKZ_SharedTable_st> sharedTable_v; // render cache of common tables
+  std::string headerCache_s; // render cache of axis header
+  bool settingsDirty_b;
+  gType_TIKZ_PlotType_e headerCacheType_e;
+  bool logOnX_b;
+  bool logOnY_b;
+  double userdefinedMinX_d;
+  double userdefinedMaxX_d;
+  double userdefinedMinY_d;
+  double userdefinedMaxY_d;
+  std::vector<std::string> additionalSettings_v;
+} gType_TIKZ_LogSettings_st;
+
 
 class CTikz {
+  // group plot writes panels out of its CTikz objects
+  friend class CTikzGroup;
+  
 public:
   
   // default constructor
   CTikz();
   
-  // copy constructor
+  // copy constructor. Data of all data set entries and their render caches are
+  // shared with the original (reference counted), only settings are copied.
+  // The copy gets its own ID.
   CTikz(const CTikz& f_orig_c);
   
+  // move constructor
+  CTikz(CTikz&& f_orig_c) = default;
+  
+  // copy assignment. Data is shared as for copy constructor, the object gets a new ID
+  // (IDs stay unique, i.e. labels of plots of both objects do not clash).
+  CTikz& operator=(const CTikz& f_orig_c);
+  
+  // move assignment
+  CTikz& operator=(CTikz&& f_orig_c) = default;
+  
   // destructor
   virtual ~CTikz();
   
@@ -75,11 +285,8 @@ public:
   void setData_vd(const gType_TIKZ_DataSetEntry_st& f_dataSetEntry_st,
                   const std::string& f_legend_s="");
   
-  // get data set
-  std::vector<gType_TIKZ_DataSetEntry_st> v_getData() const
-  {
-    return m_dataSet_v;
-  }
+  // get data set (y values of user, filters are not applied)
+  std::vector<gType_TIKZ_DataSetEntry_st> v_getData() const;
   
   // add data via C array. size is size of array dataX and dataY.
   // additional: comment, color, plot style and legend entry can be set
@@ -100,6 +307,40 @@ public:
                   const std::string& f_plotStyle_s="",
                   const std::string& f_legend_s="");
   
+  // add several data set entries with common x values, x values are stored only once.
+  // Line plots of these entries are written as one table (x column and one y column per
+  // entry) which is read once by pgfplotstableread and referenced by each addplot.
+  // additional: comment, colors, plot style and legend entries can be set (missing colors
+  // are taken from default list, missing legend entries are left out)
+  void addDataColumns_vd(const std::vector<double>& f_dataX_v,
+                         const std::vector<std::vector<double> >& f_dataY_v,
+                         const std::string& f_comment_s="",
+                         const std::vector<std::string>& f_color_v=std::vector<std::string>(),
+                         const std::string& f_plotStyle_s="",
+                         const std::vector<std::string>& f_legend_v=std::vector<std::string>());
+  
+  // add data with uniform x values (startX + k*stepX). Only start and step are stored, only y
+  // values are written into tables. Other data set entries whose x values are exactly a
+  // uniform grid are written the same way.
+  // additional: comment, color, plot style and legend entry can be set
+  void addDataUniform_vd(double f_startX_d,
+                         double f_stepX_d,
+                         const std::vector<double>& f_dataY_v,
+                         const std::string& f_comment_s="",
+                         const std::string& f_color_s="",
+                         const std::string& f_plotStyle_s="",
+                         const std::string& f_legend_s="");
+  
+  // add data with timestamps (e.g. Unix time) as x values, see setTimeAxis_vd. Timestamps are
+  // stored as seconds relative to epoch of time axis, i.e. tables contain small offsets only.
+  // additional: comment, color, plot style and legend entry can be set
+  void addDataTime_vd(const std::vector<int64_t>& f_time_v,
+                      const std::vector<double>& f_dataY_v,
+                      const std::string& f_comment_s="",
+                      const std::string& f_color_s="",
+                      const std::string& f_plotStyle_s="",
+                      const std::string& f_legend_s="");
+  
   // add data via vector with pair of double (x and y values)
   // additional: comment, color, plot style and legend entry can be set
   void addData_vd(const std::vector<std::pair<double, double> >& f_data_v,
@@ -113,6 +354,140 @@ public:
   void addData_vd(const gType_TIKZ_DataSetEntry_st& f_dataSetEntry_st,
                   const std::string& f_legend_s="");
   
+  // add envelope of many runs sharing x values: center line (mean or median) and a band
+  // between lower and upper percentile (default: minimum and maximum) are computed per x
+  // value in parallel. Only center line and band are written, i.e. size of output does not
+  // depend on number of runs. Values which are not finite are ignored.
+  void addEnvelope_vd(const std::vector<double>& f_dataX_v,
+                      const std::vector<std::vector<double> >& f_runsY_v,
+                      gType_TIKZ_Center_e f_center_e = e_TIKZ_CenterMean,
+                      double f_lowerPercentile_d = 0,
+                      double f_upperPercentile_d = 100,
+                      const std::string& f_comment_s="",
+                      const std::string& f_color_s="",
+                      const std::string& f_plotStyle_s="",
+                      const std::string& f_legend_s="");
+  
+  // add envelope of many runs with own (ascending) x values. Runs are resampled onto given
+  // grid by linear interpolation, grid points outside of a run are ignored for this run.
+  void addEnvelope_vd(const std::vector<double>& f_gridX_v,
+                      const std::vector<std::vector<double> >& f_runsX_v,
+                      const std::vector<std::vector<double> >& f_runsY_v,
+                      gType_TIKZ_Center_e f_center_e = e_TIKZ_CenterMean,
+                      double f_lowerPercentile_d = 0,
+                      double f_upperPercentile_d = 100,
+                      const std::string& f_comment_s="",
+                      const std::string& f_color_s="",
+                      const std::string& f_plotStyle_s="",
+                      const std::string& f_legend_s="");
+  
+  // add binned mean of noisy data: points are binned by x value, each non-empty bin is written
+  // as mean of its x and y values with error bar of standard error of mean. Statistics are
+  // computed in one parallel pass (see getBins_v), i.e. size of output is number of bins.
+  void addBinnedMean_vd(const std::vector<double>& f_dataX_v,
+                        const std::vector<double>& f_dataY_v,
+                        std::size_t f_bins_i,
+                        gType_TIKZ_Binning_e f_binning_e = e_TIKZ_BinningFixed,
+                        const std::string& f_comment_s="",
+                        const std::string& f_color_s="",
+                        const std::string& f_plotStyle_s="",
+                        const std::string& f_legend_s="");
+  
+  // get statistics of bins of x values (empty bins are left out). Each thread accumulates its
+  // chunk of points (Welford), accumulators of threads are merged pairwise (Chan et al.).
+  // Points which are not finite are ignored.
+  static std::vector<gType_TIKZ_Bin_st> getBins_v(const std::vector<double>& f_dataX_v,
+                                                  const std::vector<double>& f_dataY_v,
+                                                  std::size_t f_bins_i,
+                                                  gType_TIKZ_Binning_e f_binning_e = e_TIKZ_BinningFixed);
+  
+  // render data set entry (index in order of adding) as raster graphics (PNG file next to
+  // tikz file) instead of table. Marks are drawn as filled circles with given radius in pt.
+  // Axes, labels and legend stay vector graphics. Useful for scatter plots with huge data.
+  void setRaster_vd(std::size_t f_idx_i, bool f_on_b = true, double f_markSize_d = 1.0);
+  
+  // append filter to filter stages of data set entry (index in order of adding). Only
+  // settings of filter are kept, stages are applied in order to y values while data is
+  // written (bounds, tables, decimation of budget in same pass), i.e. neither caller nor
+  // CTikz keeps filtered copy of data. Raster graphics and windows of pyramid use temporary
+  // filtered column. Values of user are not changed. Not available for envelopes and error
+  // bars.
+  void addFilter_vd(std::size_t f_idx_i,
+                    gType_TIKZ_Filter_e f_filter_e,
+                    double f_value_d,
+                    unsigned int f_order_i = 2);
+  
+  // remove all filters of data set entry, y values of user are plotted again
+  void clearFilter_vd(std::size_t f_idx_i);
+  
+  // plot data set entry (index in order of adding) on second y axis at right side of line
+  // plot. Both y axes share x axis and legend, range of second y axis is determined
+  // automatically (linear scale). Code is written in one pass without label references.
+  void setSecondAxis_vd(std::size_t f_idx_i, bool f_on_b = true);
+  
+  // set resolution of raster graphics in dots per inch (default: 300)
+  void setRasterResolution_vd(double f_dpi_d);
+  
+  // set budget for estimated TeX cost of graphics. Cost is about the number of coordinates
+  // pgfplots has to process (marks and filled bands count more); pdflatex with default memory
+  // settings handles about 100000. Graphics exceeding budget is either rejected before
+  // anything is written or reduced: line plots (sorted x values, no marks) are decimated
+  // keeping minimum and maximum per bucket, afterwards data set entries are rasterized.
+  void setBudget_vd(double f_maxCost_d, gType_TIKZ_Budget_e f_budget_e = e_TIKZ_BudgetReject);
+  
+  // estimated TeX cost of graphics (line plot of all data set entries)
+  double estimateCost_d();
+  
+  // set TeX engine used to create PDF file (default: pdflatex)
+  void setEngine_vd(gType_TIKZ_Engine_e f_engine_e);
+  
+  // set directory in which private scratch directories for compiling PDF files are created
+  // (default: /dev/shm when writable, otherwise TMPDIR or /tmp). Only final PDF file and
+  // optionally latex file are moved next to tikz file.
+  void setScratchDir_vd(const std::string& f_scratchDir_s);
+  
+  // set TeX worker which keeps engine with preamble already processed waiting for next PDF
+  // file (default: none, engine is started for each PDF file). Worker can be shared.
+  void setTexWorker_vd(const std::shared_ptr<CTexWorker>& f_texWorker_p);
+  
+  // keep latex file of PDF file next to tikz file (default: true)
+  void setKeepTex_vd(bool f_keepTex_b);
+  
+  // set timeout in seconds for each run of TeX engine (default: 300, 0: no timeout).
+  // Engine is killed after timeout and creation of PDF file fails with exception.
+  void setPdfTimeout_vd(double f_timeout_d);
+  
+  // split tables of line plots with more than given number of coordinates into several
+  // chained addplot commands (0: no splitting). Chunks overlap by one coordinate, i.e. lines
+  // stay connected; legend entry and label refer to last chunk.
+  void setChunkSize_vd(std::size_t f_chunkSize_i);
+  
+  // switch on or off arena mode: memory of rendering (buffer of tikz code) is kept between
+  // files instead of being allocated for each file and released in bulk by clear_vd() or
+  // destruction. Useful when one object creates many small figures.
+  void setArena_vd(bool f_on_b = true);
+  
+  // set precision of coordinates in tables of line plots. Digits: value is number of
+  // significant digits. Axis: coordinates are rounded to power of ten below size of one dot
+  // of axis (range of axis over width or height of plot, value is dots per inch, 0: raster
+  // resolution), only digits which can change rendered graphics are written; logarithmic
+  // axes get significant digits accordingly. Needs absolute width and height (e.g. 10cm).
+  void setPrecision_vd(gType_TIKZ_Precision_e f_precision_e, double f_value_d = 0);
+  
+  // x axis is time axis: x values are seconds relative to epoch (timestamp in given unit, e.g.
+  // start of capture), ticks are labeled with date and time (UTC) computed by CTikz. Has to
+  // be set before data is added with addDataTime_vd, epoch and unit cannot be changed while
+  // such data exists (throws). Range of x axis is given in seconds relative to epoch as well.
+  void setTimeAxis_vd(int64_t f_epoch_i, gType_TIKZ_TimeUnit_e f_unit_e = e_TIKZ_TimeUnitSeconds);
+  
+  // write line plots of sorted data (no marks, no envelope) only within range of x axis,
+  // decimated to minimum and maximum per dot of plot width (value is dots per inch, 0: raster
+  // resolution). Index of each data set entry is built once at first use and shared by
+  // copies, i.e. zoom series or frames of sliding window of one capture cost time
+  // logarithmic in size of data each. Automatic range of y axis is determined within window
+  // (including last point before and first point after window). Needs absolute width.
+  void setPyramid_vd(bool f_on_b = true, double f_dotsPerInch_d = 0);
+  
   // set title of plot
   void setTitle_vd(const std::string& f_title_s);
   
@@ -140,6 +515,15 @@ public:
     return m_yLabel_s;
   }
   
+  // set label for second y axis of plot (see setSecondAxis_vd)
+  void setY2label_vd(const std::string& f_y2Label_s);
+  
+  // get label for second y axis of plot
+  std::string getY2label_s() const
+  {
+    return m_y2Label_s;
+  }
+  
   // set label for x and for y axis of plot
   void setLabel_vd(const std::string& f_xLabel_s,
                    const std::string& f_yLabel_s);
@@ -204,6 +588,11 @@ public:
   // set on or off log scale of plot for y axis
   void setLogY_vd(bool b_on_b = true);
   
+  // compute log10 of coordinates of log axes in C++ instead of TeX (line plots). Values which
+  // are not positive are left out (gaps), axis is linear in log10 of values with tick labels
+  // of powers of ten. Not used for shared range of group plot.
+  void setLogPreprocessing_vd(bool f_on_b = true);
+  
   // set additional settings for tikz file
   void setAdditionalSettings_vd(const std::string& f_settings_s);
   
@@ -265,7 +654,36 @@ public:
                             double f_dataMin_d,
                             double f_dataMax_d);
   
+  // create tikz file as 2D histogram (heatmap) of all data set entries. Binning is done by
+  // CTikz within axis range (in parallel), only bin counts are written into tikz file: as
+  // matrix plot table or as raster graphics (PNG file next to tikz file). A colorbar is added.
+  void createTikzFileHist2d_vd(const std::string& f_filename_s,
+                               int f_binsX_i,
+                               int f_binsY_i,
+                               bool f_raster_b = false);
+  
+  // create tikz file and PDF file as preview with corresponding latex file
+  // graphics is generated as 2D histogram (heatmap)
+  void createTikzPdfHist2d_vd(const std::string& f_filename_s,
+                              int f_binsX_i,
+                              int f_binsY_i,
+                              bool f_raster_b = false);
+  
+  // create tikz file with one box plot per data set entry (y values, x values are ignored).
+  // Quantiles and whiskers (1.5 interquartile range) are computed by CTikz, only the
+  // summary and at most f_maxOutliers outliers (evenly spread, extremes included) are
+  // written. Legend entries are used as labels of the boxes.
+  void createTikzFileBox_vd(const std::string& f_filename_s,
+                            int f_maxOutliers_i = 100);
+  
+  // create tikz file and PDF file as preview with corresponding latex file
+  // graphics is generated as box plot
+  void createTikzPdfBox_vd(const std::string& f_filename_s,
+                           int f_maxOutliers_i = 100);
+  
   // creates tikz code which can used for a second axis in another CTikz object.
+  // Legend entries of plots of other object refer to labels of the object into which
+  // the code is inserted (see setSecondAxisCode_vd).
   void createSecondAxisCode_vd(std::string& f_secondAxisCode_s);
   
   // set code for second axis of plot
@@ -283,17 +701,34 @@ public:
   // set additional info into tikz file
   void setInfo_vd(const std::string& f_info_s);
   
+  // save complete state (data sets, legends, settings, commands, second axis code)
+  // into compact binary file. File can be loaded to re-render figure without raw data.
+  void saveState_vd(const std::string& f_filename_s);
+  
+  // load complete state from binary file created by saveState_vd (file is memory mapped).
+  // current state is replaced.
+  void loadState_vd(const std::string& f_filename_s);
+  
   
 private:
   
-  // data set means all data
-  std::vector<gType_TIKZ_DataSetEntry_st> m_dataSet_v;
+  // data set means all data (data and render cache of each entry are shared between copies)
+  std::vector<gType_TIKZ_DataSet_st> m_dataSet_v;
+  
+  // render cache for tables of data set entries with common x column
+  std::vector<gType_TIKZ_SharedTable_st> m_sharedTable_v;
+  
+  // render cache for axis header, i.e. all settings before first plot
+  std::string m_headerCache_s; // cached header
+  bool m_settingsDirty_b; // header has to be recreated
+  gType_TIKZ_PlotType_e m_headerCacheType_e; // type of graphics of cached header
   
   // settings for tikz plot
   std::string m_title_s; // title of plot
   std::vector<std::string> m_legend_v; // legend entries of plot
   std::string m_xLabel_s; // label for x axis
   std::string m_yLabel_s; // label for y axis
+  std::string m_y2Label_s; // label for second y axis
   std::string m_legendStyle_s; // style of legend
   std::string m_legendTitle_s; // title of legend
   std::string m_width_s; // with of plot
@@ -321,28 +756,220 @@ private:
   std::string m_author_s; // author written into tikz file
   std::string m_info_s; // info written into tikz file
   std::string m_id_s; // ID for plots
+  double m_rasterResolution_d; // resolution of raster graphics in dots per inch
+  double m_budgetMaxCost_d; // budget for estimated TeX cost of graphics
+  gType_TIKZ_Budget_e m_budget_e; // handling of graphics exceeding budget
+  gType_TIKZ_Engine_e m_engine_e; // TeX engine used to create PDF file
+  double m_pdfTimeout_d; // timeout of TeX engine in seconds (not part of stored state)
+  std::string m_scratchDir_s; // base of scratch directories, empty: default (not part of stored state)
+  bool m_keepTex_b; // latex file is kept next to tikz file (not part of stored state)
+  std::shared_ptr<CTexWorker> m_texWorker_p; // TeX worker, shared by copies (not part of stored state)
+  std::size_t m_chunkSize_i; // maximum number of coordinates of one addplot (0: unlimited)
+  gType_TIKZ_Precision_e m_precision_e; // precision of coordinates in tables
+  double m_precisionValue_d; // significant digits or dots per inch of precision
+  bool m_logPreprocess_b; // log10 of coordinates of log axes is computed in C++
+  bool m_arena_b; // memory of rendering is kept between files (not part of stored state)
+  std::string m_renderBuffer_s; // tikz code of file, keeps its capacity in arena mode
+  bool m_splitAxes_b; // data set entries of second y axis are written into own axis (while code is created)
+  bool m_timeAxis_b; // x axis is time axis
+  int64_t m_timeEpoch_i; // epoch of time axis (x value 0) in unit of timestamps
+  gType_TIKZ_TimeUnit_e m_timeUnit_e; // unit of timestamps
+  bool m_timeData_b; // data set entries with timestamps exist, i.e. epoch and unit are fixed
+  bool m_pyramid_b; // line plots are written within range of x axis only (min/max pyramid)
+  double m_pyramidDpi_d; // dots per inch of windows of pyramid, 0: raster resolution
   
   // create PDF file
   void m_createPdf_vd(const std::string& f_filenameTikz_s);
   
   // create tikz file
   void m_createTikzFile_vd(const std::string& f_filename_s,
-                           bool f_createHist_b,
-                           int f_bins_i = 0,
-                           double f_dataMin_d = 0,
-                           double f_dataMax_d = 0);
+                           const gType_TIKZ_PlotParam_st& f_plotParam_st);
+
+  // append tikz code to given string. Raster graphics are named after given tikz file name.
+  void m_createTikzCode_vd(std::string& f_tikz_s,
+                           const std::string& f_filename_s,
+                           const gType_TIKZ_PlotParam_st& f_plotParam_st);
+  
+  // estimate TeX cost of graphics of given data set entries
+  double m_estimateCost_d(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                          const std::vector<gType_TIKZ_DataSet_st>& f_dataSet_v);
+  
+  // check graphics against budget. Returns true when data set entries had to be reduced,
+  // reduced data set entries are given back. Throws when graphics does not fit.
+  bool m_applyBudget_b(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                       std::vector<gType_TIKZ_DataSet_st>& f_dataSetReduced_v);
+  
+  // cut data set entries to window of x axis (see setPyramid_vd). Returns true when any data
+  // set entry was cut, cut data set entries are given back.
+  bool m_applyWindow_b(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                       std::vector<gType_TIKZ_DataSet_st>& f_dataSetWindow_v);
+  
+  // replace data set entries by log10 of their coordinates and log axes by linear axes with
+  // tick labels of powers of ten (line plots with log preprocessing). Returns true when
+  // settings of user were replaced, they are given back.
+  bool m_beginLogTransform_b(const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                             gType_TIKZ_LogSettings_st& f_settings_st);
+  
+  // restore settings of user replaced by m_beginLogTransform_b
+  void m_endLogTransform_vd(gType_TIKZ_LogSettings_st& f_settings_st);
+  
+  // get tick options of linear axis of log10 values (e.g. axis "x")
+  std::string m_getLogTicks_s(const std::string& f_axis_s, double f_min_d, double f_max_d);
+  
+  // get tick options of time axis (x values are seconds relative to epoch)
+  std::string m_getTimeTicks_s(double f_min_d, double f_max_d);
+  
+  // get axis header, recreated only when settings or type of graphics changed
+  const std::string& m_getHeader_s(gType_TIKZ_PlotType_e f_plotType_e);
+  
+  // get header of panel in group plot
+  std::string m_getPanelHeader_s(const gType_TIKZ_PlotParam_st& f_plotParam_st);
+  
+  // write options of axis, ranges are only written when requested
+  void m_writeAxisOptions_vd(std::stringstream& f_tikz_ss,
+                             gType_TIKZ_PlotType_e f_plotType_e,
+                             bool f_rangeX_b,
+                             bool f_rangeY_b);
+  
+  // write addplot code of all data set entries, raster graphics are written into files
+  void m_writePlots_vd(std::string& f_code_s,
+                       const std::string& f_filename_s,
+                       const gType_TIKZ_PlotParam_st& f_plotParam_st,
+                       bool f_secondAxis_b);
+  
+  // write axis of data set entries of second y axis on top of first axis (shared x axis)
+  void m_writeSecondAxis_vd(std::string& f_code_s,
+                            const std::string& f_filename_s,
+                            const gType_TIKZ_PlotParam_st& f_plotParam_st);
+  
+  // write table of data set entry split into chained addplot commands
+  void m_writeChunks_vd(std::string& f_code_s, std::size_t f_idx_i, bool f_secondAxis_b);
+  
+  // write addplot of data set entry referencing column of common table. Table is written
+  // before first plot of it (written tables are collected in f_sharedX_v).
+  void m_writeSharedPlot_vd(std::string& f_code_s,
+                            std::size_t f_idx_i,
+                            std::vector<gType_TIKZ_Column_p>& f_sharedX_v,
+                            bool f_secondAxis_b);
+  
+  // get program of TeX engine
+  std::string m_getEngine_s();
+  
+  // get program and arguments of TeX engine to translate given latex file
+  std::vector<std::string> m_getEngineArgs_v(const std::string& f_filenameTex_s, const std::string& f_path_s);
+  
+  // get preamble of latex file for PDF file
+  std::string m_getPreamble_s();
+  
+  // get first error message of TeX engine out of log file, output of engine as fallback
+  std::string m_getTexError_s(const std::string& f_filenameLog_s, const std::string& f_output_s);
+  
+  // throw exception for failed run of TeX engine
+  void m_throwTexError_vd(const gType_PROCESS_Result_st& f_result_st,
+                          const std::string& f_filenameTex_s,
+                          const std::string& f_filenameLog_s);
+  
+  // write band of envelope of data set entry
+  void m_writeEnvelopeBand_vd(std::string& f_code_s, std::size_t f_idx_i);
+  
+  // write 2D histogram of all data set entries as matrix plot or raster graphics
+  void m_writeHist2d_vd(std::string& f_code_s,
+                        const std::string& f_filename_s,
+                        const gType_TIKZ_PlotParam_st& f_plotParam_st);
+  
+  // write box plot of each data set entry
+  void m_writeBox_vd(std::string& f_code_s,
+                     const gType_TIKZ_PlotParam_st& f_plotParam_st);
+  
+  // get default parameters of graphics for given type
+  gType_TIKZ_PlotParam_st m_createPlotParam_st(gType_TIKZ_PlotType_e f_plotType_e);
+  
+  // get render cache (bounds and table) of data set entry, recreated when dirty or when
+  // format of tables changed
+  const gType_TIKZ_DataSetCache_st& m_getCache_st(std::size_t f_idx_i);
+  
+  // get render cache of data set entry with at least bounds
+  const gType_TIKZ_DataSetCache_st& m_getBounds_st(std::size_t f_idx_i);
+  
+  // create render cache of data set entry. Table is only created on request.
+  std::shared_ptr<const gType_TIKZ_DataSetCache_st> m_createCache_p(const gType_TIKZ_DataSet_st& f_dataSet_st,
+                                                                    bool f_createTable_b);
+  
+  // data set entry is line plot which shares its x column with another line plot, i.e.
+  // it is written as column of common table
+  bool m_isSharedX_b(std::size_t f_idx_i) const;
+  
+  // get table of data set entries with common x column (recreated when columns or format
+  // of tables changed)
+  const std::string& m_getSharedTable_s(const std::vector<std::size_t>& f_idx_v);
+  
+  // get format of coordinates of x or y axis in tables according to precision
+  gType_TIKZ_NumberFormat_st m_getNumberFormat_st(bool f_axisY_b, bool f_secondAxis_b = false);
+  
+  // data set entry is written into second y axis
+  bool m_isSecondAxis_b(const gType_TIKZ_DataSet_st& f_dataSet_st) const
+  {
+    return m_splitAxes_b && f_dataSet_st.secondAxis_b;
+  }
+  
+  // render data set entry into PNG file with size and range of axis
+  void m_writeRaster_vd(std::size_t f_idx_i, const std::string& f_filename_s);
+  
+  // convert length like "10cm" into inch
+  double m_getLengthInch_d(const std::string& f_length_s);
+  
+  // get RGB values of color name (user defined colors of latex commands, default colors)
+  void m_getColorRgb_vd(const std::string& f_color_s, unsigned char* f_rgb_p);
+  
+  // add data columns as new data set entry, default color is used when no color is given.
+  // Columns of envelope and error bars are optional. x column of uniform grid is null (start
+  // and step are set by caller).
+  void m_addDataColumns_vd(const gType_TIKZ_Column_p& f_dataX_p,
+                           const gType_TIKZ_Column_p& f_dataY_p,
+                           const std::string& f_comment_s,
+                           const std::string& f_color_s,
+                           const std::string& f_plotStyle_s,
+                           const std::string& f_legend_s,
+                           const gType_TIKZ_Column_p& f_lower_p = gType_TIKZ_Column_p(),
+                           const gType_TIKZ_Column_p& f_upper_p = gType_TIKZ_Column_p(),
+                           const gType_TIKZ_Column_p& f_error_p = gType_TIKZ_Column_p());
+  
+  // compute center line and band of runs (given on x values of envelope) and add envelope
+  void m_addEnvelope_vd(const std::vector<double>& f_dataX_v,
+                        const std::vector<const std::vector<double>*>& f_runsY_v,
+                        gType_TIKZ_Center_e f_center_e,
+                        double f_lowerPercentile_d,
+                        double f_upperPercentile_d,
+                        const std::string& f_comment_s,
+                        const std::string& f_color_s,
+                        const std::string& f_plotStyle_s,
+                        const std::string& f_legend_s);
+  
+  // add data set entry (render cache is dirty)
+  void m_pushDataSet_vd(const gType_TIKZ_DataSet_st& f_dataSet_st);
+  
+  // convert data set entry of user interface into internal representation
+  gType_TIKZ_DataSet_st m_createDataSet_st(const gType_TIKZ_DataSetEntry_st& f_dataSetEntry_st);
+  
+  // remove all data set entries and their render caches
+  void m_clearDataSet_vd();
 
   // helper functions
   double m_getMinX_d(); // get minimum x value
   double m_getMaxX_d(); // get maximum x value
   double m_getMinY_d(); // get minimum y value
   double m_getMaxY_d(); // get maximum y value
+  double m_getMinY2_d(); // get minimum y value of second y axis
+  double m_getMaxY2_d(); // get maximum y value of second y axis
 
   std::string m_createId_s(); // create ID
   
   bool m_fileExist_b(const std::string& f_filename_s); // check if file exists
   
   std::string m_trimFilename_s(const std::string& f_filename_s); // trim file name
+  
+  // split file name into base and extension (with dot, empty when file name has no extension)
+  static void m_splitFilename_vd(const std::string& f_filename_s, std::string& f_base_s, std::string& f_extension_s);
 };
 
 #endif	/* CTIKZ_HPP */
@@ -359,6 +986,7 @@ private:
 //   b  : bool
 //   c  : class
 //   d  : double
+//   e  : enum
 //   f  : float
 //   i  : int
 //   s  : std::string
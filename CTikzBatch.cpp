@@ -0,0 +1,142 @@
+/**
+ * @file CTikzBatch.cpp
+ * @brief CTikzBatch class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Pool of worker threads which creates many tikz files (and PDF files) in parallel.
+ *
+ */
+
+#include <exception>
+#include <sstream>
+#include "CTikzBatch.hpp"
+#include "CException.hpp"
+#include "CParallel.hpp"
+
+
+// ========================================================================
+// CTikzBatch - constructor, starts worker threads
+// ========================================================================
+CTikzBatch::CTikzBatch(unsigned int f_numThreads_i)
+{
+  m_numPending_i = 0;
+  m_stop_b = false;
+  const unsigned int l_numThreads_i = (0 == f_numThreads_i) ? CParallel::numThreads_i() : f_numThreads_i;
+  m_thread_v.reserve(l_numThreads_i);
+  for (unsigned int l_k_i = 0; l_k_i < l_numThreads_i; ++l_k_i) {
+    m_thread_v.push_back(std::thread(&CTikzBatch::m_work_vd, this));
+  }
+}
+
+
+// ========================================================================
+// ~CTikzBatch - destructor, queued jobs are finished before workers stop
+// ========================================================================
+CTikzBatch::~CTikzBatch()
+{
+  {
+    std::lock_guard<std::mutex> l_lock_c(m_mutex_c);
+    m_stop_b = true;
+  }
+  m_jobAdded_c.notify_all();
+  for (std::vector<std::thread>::iterator l_thread_it = m_thread_v.begin(); l_thread_it != m_thread_v.end(); ++l_thread_it) {
+    l_thread_it->join();
+  }
+}
+
+
+// ========================================================================
+// queue copy of figure
+// ========================================================================
+void CTikzBatch::add_vd(const CTikz& f_tikz_c, const std::string& f_filename_s, bool f_pdf_b)
+{
+  std::shared_ptr<CTikz> l_tikz_p = std::make_shared<CTikz>(f_tikz_c);
+  add_vd([l_tikz_p, f_filename_s, f_pdf_b]() {
+    if (f_pdf_b) {
+      l_tikz_p->createTikzPdf_vd(f_filename_s);
+    } else {
+      l_tikz_p->createTikzFile_vd(f_filename_s);
+    }
+  });
+}
+
+
+// ========================================================================
+// queue job
+// ========================================================================
+void CTikzBatch::add_vd(const gType_BATCH_Job_c& f_job_c)
+{
+  {
+    std::lock_guard<std::mutex> l_lock_c(m_mutex_c);
+    m_job_v.push_back(f_job_c);
+    ++m_numPending_i;
+  }
+  m_jobAdded_c.notify_one();
+}
+
+
+// ========================================================================
+// wait until all queued jobs are done, errors are reported once
+// ========================================================================
+void CTikzBatch::wait_vd()
+{
+  std::vector<std::string> l_error_v;
+  {
+    std::unique_lock<std::mutex> l_lock_c(m_mutex_c);
+    while (0 != m_numPending_i) {
+      m_jobDone_c.wait(l_lock_c);
+    }
+    l_error_v.swap(m_error_v);
+  }
+  if (!l_error_v.empty()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "CTikzBatch::wait(): " << l_error_v.size() << " figure(s) failed, first error: " << l_error_v.front();
+    std::stringstream l_details_ss;
+    for (std::vector<std::string>::const_iterator l_error_it = l_error_v.begin(); l_error_it != l_error_v.end(); ++l_error_it) {
+      l_details_ss << *l_error_it << std::endl;
+    }
+    throw CException(l_msg_ss.str(), l_details_ss.str());
+  }
+}
+
+
+// ========================================================================
+// worker thread: take next job from queue until stopped. Loops inside of
+// job are not split into further threads.
+// ========================================================================
+void CTikzBatch::m_work_vd()
+{
+  CParallel::setSerial_vd(true);
+  while (true) {
+    gType_BATCH_Job_c l_job_c;
+    {
+      std::unique_lock<std::mutex> l_lock_c(m_mutex_c);
+      while (m_job_v.empty() && !m_stop_b) {
+        m_jobAdded_c.wait(l_lock_c);
+      }
+      if (m_job_v.empty()) { // stopped
+        return;
+      }
+      l_job_c.swap(m_job_v.front());
+      m_job_v.pop_front();
+    }
+    std::string l_error_s;
+    try {
+      l_job_c();
+    } catch (std::exception& f_exception_c) {
+      l_error_s = f_exception_c.what();
+    } catch (...) {
+      l_error_s = "unknown exception";
+    }
+    {
+      std::lock_guard<std::mutex> l_lock_c(m_mutex_c);
+      if (!l_error_s.empty()) {
+        m_error_v.push_back(l_error_s);
+      }
+      --m_numPending_i;
+    }
+    m_jobDone_c.notify_all();
+  }
+}
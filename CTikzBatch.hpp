@@ -0,0 +1,80 @@
+/**
+ * @file CTikzBatch.hpp
+ * @brief CTikzBatch class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Pool of worker threads which creates many tikz files (and PDF files) in parallel.
+ *   Figures are copies of CTikz objects (data is shared, not copied), i.e. original objects
+ *   can be changed or destroyed after adding. Loops inside a figure are processed serially
+ *   by the worker, parallelism is given by the number of workers. Errors of figures are
+ *   collected and reported by wait_vd.
+ *
+ * usage:\n
+ * \code
+ * CTikzBatch l_batch_c;
+ * for (std::size_t l_k_i = 0; l_k_i < l_tikz_v.size(); ++l_k_i) {
+ *   l_batch_c.add_vd(l_tikz_v[l_k_i], "figure" + std::to_string(l_k_i) + ".tikz");
+ * }
+ * l_batch_c.add_vd([&]() { l_hist_c.createTikzFileHist_vd("hist.tikz", 20, 0, 1); });
+ * l_batch_c.wait_vd(); // throws when figures failed
+ * \endcode
+ *
+ */
+
+#ifndef CTIKZBATCH_HPP
+#define	CTIKZBATCH_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CTikz.hpp"
+
+class CTikzBatch {
+public:
+  
+  // job creating one figure
+  typedef std::function<void()> gType_BATCH_Job_c;
+  
+  // constructor, starts given number of worker threads (0: number of cores)
+  CTikzBatch(unsigned int f_numThreads_i = 0);
+  
+  // destructor, waits for all queued figures (errors are dropped)
+  ~CTikzBatch();
+  
+  // queue copy of figure, tikz file (and PDF file) is created by a worker
+  void add_vd(const CTikz& f_tikz_c, const std::string& f_filename_s, bool f_pdf_b = false);
+  
+  // queue job, job must not use objects which are used by other jobs at the same time
+  void add_vd(const gType_BATCH_Job_c& f_job_c);
+  
+  // wait until all queued figures are created. Throws CException when figures failed
+  // (message of first error, details contain messages of all errors).
+  void wait_vd();
+  
+private:
+  
+  // not copyable, workers belong to one batch
+  CTikzBatch(const CTikzBatch& f_orig_c) = delete;
+  CTikzBatch& operator=(const CTikzBatch& f_orig_c) = delete;
+  
+  std::vector<std::thread> m_thread_v; // worker threads
+  std::deque<gType_BATCH_Job_c> m_job_v; // queued jobs
+  std::mutex m_mutex_c; // protects queue, counters and errors
+  std::condition_variable m_jobAdded_c; // signals queued job or stop
+  std::condition_variable m_jobDone_c; // signals finished job
+  std::size_t m_numPending_i; // number of queued and running jobs
+  std::vector<std::string> m_error_v; // messages of failed jobs
+  bool m_stop_b; // workers stop when queue is empty
+  
+  // worker thread: process jobs until stopped
+  void m_work_vd();
+};
+
+#endif	/* CTIKZBATCH_HPP */
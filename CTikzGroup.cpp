@@ -0,0 +1,223 @@
+/**
+ * @file CTikzGroup.cpp
+ * @brief CTikzGroup class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Grid of several CTikz axes (small multiples) in one tikz picture (pgfplots
+ *   group plot).
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "CTikzGroup.hpp"
+#include "CException.hpp"
+
+
+// ========================================================================
+// CTikzGroup - constructor
+// ========================================================================
+CTikzGroup::CTikzGroup()
+{
+  clear_vd();
+}
+
+
+// ========================================================================
+// ~CTikzGroup - destructor
+// ========================================================================
+CTikzGroup::~CTikzGroup()
+{
+}
+
+
+// ========================================================================
+// remove all panels and set default values
+// ========================================================================
+void CTikzGroup::clear_vd()
+{
+  m_panel_v.clear();
+  m_columns_i = 2;
+  m_sharedX_b = false;
+  m_sharedY_b = false;
+  m_groupStyle_s = "";
+}
+
+
+// ========================================================================
+// add copy of CTikz object as next panel
+// ========================================================================
+std::size_t CTikzGroup::addPanel_vd(const CTikz& f_panel_c)
+{
+  m_panel_v.push_back(f_panel_c);
+  return m_panel_v.size() - 1;
+}
+
+
+// ========================================================================
+// get panel
+// ========================================================================
+CTikz& CTikzGroup::getPanel_c(std::size_t f_idx_i)
+{
+  return m_panel_v.at(f_idx_i);
+}
+
+
+// ========================================================================
+// set number of columns of grid
+// ========================================================================
+void CTikzGroup::setColumns_vd(int f_columns_i)
+{
+  if (f_columns_i <= 0) {
+    throw CException("CTikzGroup::setColumns(): number of columns must be positive.");
+  }
+  m_columns_i = f_columns_i;
+}
+
+
+// ========================================================================
+// share range of x axis and/or y axis between all panels
+// ========================================================================
+void CTikzGroup::setSharedRange_vd(bool f_sharedX_b, bool f_sharedY_b)
+{
+  m_sharedX_b = f_sharedX_b;
+  m_sharedY_b = f_sharedY_b;
+}
+
+
+// ========================================================================
+// set additional options of group style
+// ========================================================================
+void CTikzGroup::setGroupStyle_vd(const std::string& f_groupStyle_s)
+{
+  m_groupStyle_s = f_groupStyle_s;
+}
+
+
+// ========================================================================
+// create tikz file of all panels
+// ========================================================================
+void CTikzGroup::createTikzFile_vd(const std::string& f_filename_s)
+{
+  std::ifstream l_exist_c(f_filename_s.c_str());
+  if (l_exist_c.good()) {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "File \"" << f_filename_s << "\" already exists.";
+    throw CException(l_msg_ss.str());
+  }
+  const std::string l_tikz_s = m_createTikzCode_s(f_filename_s);
+  
+  std::ofstream l_file_c;
+  l_file_c.open(f_filename_s.c_str());
+  if (l_file_c) {
+    l_file_c.write(l_tikz_s.data(), l_tikz_s.size());
+  } else {
+    std::stringstream l_msg_ss;
+    l_msg_ss << "Cannot write into file \"" << f_filename_s << "\".";
+    throw CException(l_msg_ss.str());
+  }
+  l_file_c.close();
+}
+
+
+// ========================================================================
+// create tikz file and PDF file as preview. All panels are translated in
+// one run of TeX engine.
+// ========================================================================
+void CTikzGroup::createTikzPdf_vd(const std::string& f_filenameTikz_s)
+{
+  createTikzFile_vd(f_filenameTikz_s);
+  
+  // additional latex commands (e.g. colors) of all panels, identical commands only once
+  CTikz l_pdf_c(m_panel_v.front());
+  for (std::size_t l_k_i = 1; l_k_i < m_panel_v.size(); ++l_k_i) {
+    const std::string& l_commands_s = m_panel_v[l_k_i].m_additionalLatexCommands_s;
+    if (!l_commands_s.empty() && (std::string::npos == l_pdf_c.m_additionalLatexCommands_s.find(l_commands_s))) {
+      l_pdf_c.m_additionalLatexCommands_s += l_commands_s;
+    }
+  }
+  l_pdf_c.m_createPdf_vd(f_filenameTikz_s);
+}
+
+
+// ========================================================================
+// create tikz code of group plot. Shared ranges are written into options
+// of group plot, each panel writes its own axis options and plots.
+// ========================================================================
+std::string CTikzGroup::m_createTikzCode_s(const std::string& f_filename_s)
+{
+  if (m_panel_v.empty()) {
+    throw CException("CTikzGroup::createTikzFile(): group plot has no panels.");
+  }
+  
+  // shared range over all panels
+  double l_minX_d = std::numeric_limits<double>::max();
+  double l_maxX_d = -std::numeric_limits<double>::max();
+  double l_minY_d = std::numeric_limits<double>::max();
+  double l_maxY_d = -std::numeric_limits<double>::max();
+  for (std::vector<CTikz>::iterator l_panel_it = m_panel_v.begin(); l_panel_it != m_panel_v.end(); ++l_panel_it) {
+    if (m_sharedX_b) {
+      l_minX_d = std::min(l_minX_d, l_panel_it->m_getMinX_d());
+      l_maxX_d = std::max(l_maxX_d, l_panel_it->m_getMaxX_d());
+    }
+    if (m_sharedY_b) {
+      l_minY_d = std::min(l_minY_d, l_panel_it->m_getMinY_d());
+      l_maxY_d = std::max(l_maxY_d, l_panel_it->m_getMaxY_d());
+    }
+  }
+  
+  const CTikz& l_first_c = m_panel_v.front();
+  const std::size_t l_columns_i = static_cast<std::size_t>(m_columns_i);
+  const std::size_t l_rows_i = (m_panel_v.size() + l_columns_i - 1) / l_columns_i;
+  std::stringstream l_tikz_ss;
+  l_tikz_ss << "% file automatically generated by CTikz" << std::endl;
+  l_tikz_ss << "% author: " << l_first_c.m_author_s << std::endl;
+  l_tikz_ss << "% " << std::endl;
+  l_tikz_ss << "% info: " << l_first_c.m_info_s << std::endl;
+  l_tikz_ss << "% " << std::endl;
+  l_tikz_ss << "\\begin{tikzpicture}" << std::endl;
+  l_tikz_ss << "\\begin{groupplot}[" << std::endl;
+  if (m_sharedX_b) {
+    l_tikz_ss << "xmin=" << l_minX_d << "," << std::endl;
+    l_tikz_ss << "xmax=" << l_maxX_d << "," << std::endl;
+  }
+  if (m_sharedY_b) {
+    l_tikz_ss << "ymin=" << l_minY_d << "," << std::endl;
+    l_tikz_ss << "ymax=" << l_maxY_d << "," << std::endl;
+  }
+  l_tikz_ss << "group style={group size=" << l_columns_i << " by " << l_rows_i;
+  if (m_sharedX_b) {
+    l_tikz_ss << ", xlabels at=edge bottom, xticklabels at=edge bottom";
+  }
+  if (m_sharedY_b) {
+    l_tikz_ss << ", ylabels at=edge left, yticklabels at=edge left";
+  }
+  if (!m_groupStyle_s.empty()) {
+    l_tikz_ss << ", " << m_groupStyle_s;
+  }
+  l_tikz_ss << "}" << std::endl;
+  l_tikz_ss << "]" << std::endl;
+  std::string l_tikz_s = l_tikz_ss.str();
+  
+  // raster graphics of panels are named after panel
+  std::string l_filenameBase_s;
+  std::string l_extension_s;
+  CTikz::m_splitFilename_vd(f_filename_s, l_filenameBase_s, l_extension_s);
+  for (std::size_t l_k_i = 0; l_k_i < m_panel_v.size(); ++l_k_i) {
+    CTikz& l_panel_c = m_panel_v[l_k_i];
+    gType_TIKZ_PlotParam_st l_plotParam_st = l_panel_c.m_createPlotParam_st(e_TIKZ_PlotTypeLine);
+    l_plotParam_st.groupPanel_b = true;
+    l_plotParam_st.sharedX_b = m_sharedX_b;
+    l_plotParam_st.sharedY_b = m_sharedY_b;
+    std::stringstream l_filenamePanel_ss;
+    l_filenamePanel_ss << l_filenameBase_s << "_panel" << l_k_i << l_extension_s;
+    l_panel_c.m_createTikzCode_vd(l_tikz_s, l_filenamePanel_ss.str(), l_plotParam_st);
+  }
+  l_tikz_s += "\\end{groupplot}\n";
+  l_tikz_s += "\\end{tikzpicture}%\n";
+  return l_tikz_s;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file CTikzGroup.hpp
+ * @brief CTikzGroup class
+ * @author Michael Bernhard
+ *
+ * Created on 19. October 2026
+ *
+ * @details Grid of several CTikz axes (small multiples) in one tikz picture (pgfplots
+ *   group plot). Ranges of x and y axes can be shared by all panels: shared range is
+ *   computed once over all panels and written into options of group plot, tick labels and
+ *   axis labels are then only written at outer panels. All panels are translated in one
+ *   run of TeX engine. Latex document has to load pgfplots library groupplots.
+ *
+ * usage:\n
+ * \code
+ * CTikzGroup l_group_c;
+ * l_group_c.setColumns_vd(3);
+ * for (int l_k_i = 0; l_k_i < 9; ++l_k_i) {
+ *   CTikz l_panel_c;
+ *   l_panel_c.addData_vd(l_x_v, l_y_vv[l_k_i]);
+ *   l_group_c.addPanel_vd(l_panel_c);
+ * }
+ * l_group_c.setSharedRange_vd(true, true);
+ * l_group_c.createTikzPdf_vd("grid.tikz");
+ * \endcode
+ *
+ */
+
+#ifndef CTIKZGROUP_HPP
+#define	CTIKZGROUP_HPP
+
+#include <string>
+#include <vector>
+#include "CTikz.hpp"
+
+class CTikzGroup {
+public:
+  
+  // constructor
+  CTikzGroup();
+  
+  // destructor
+  ~CTikzGroup();
+  
+  // remove all panels and set default values
+  void clear_vd();
+  
+  // add copy of CTikz object as next panel (row by row), data is shared with original.
+  // Only axis and plots of panel are used, i.e. second axis and commands after begin of
+  // tikz picture are ignored. Returns index of panel.
+  std::size_t addPanel_vd(const CTikz& f_panel_c);
+  
+  // get panel to change it after adding
+  CTikz& getPanel_c(std::size_t f_idx_i);
+  
+  // get number of panels
+  std::size_t getNumPanels_i() const {
+    return m_panel_v.size();
+  }
+  
+  // set number of columns of grid (default: 2), number of rows follows from number of panels
+  void setColumns_vd(int f_columns_i);
+  
+  // share range of x axis and/or y axis between all panels (default: not shared)
+  void setSharedRange_vd(bool f_sharedX_b, bool f_sharedY_b);
+  
+  // set additional options of group style, e.g. "horizontal sep=1.5cm"
+  void setGroupStyle_vd(const std::string& f_groupStyle_s);
+  
+  // create tikz file of all panels
+  void createTikzFile_vd(const std::string& f_filename_s);
+  
+  // create tikz file and PDF file as preview (settings of PDF file, e.g. engine, are
+  // taken from first panel, additional latex commands of all panels are used)
+  void createTikzPdf_vd(const std::string& f_filenameTikz_s);
+  
+private:
+  std::vector<CTikz> m_panel_v; // panels
+  int m_columns_i; // number of columns of grid
+  bool m_sharedX_b; // range of x axis is shared
+  bool m_sharedY_b; // range of y axis is shared
+  std::string m_groupStyle_s; // additional options of group style
+  
+  // create tikz code of group plot
+  std::string m_createTikzCode_s(const std::string& f_filename_s);
+};
+
+#endif	/* CTIKZGROUP_HPP */
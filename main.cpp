@@ -5,14 +5,26 @@
  *
  * Created on 18. November 2017
  *
- * @details Four examples how CTikz class can be used. Make sure latex is installed.
+ * @details Examples how CTikz class can be used. Examples from fifth on check results and
+ *   print them, program returns 1 when a check fails. Make sure latex is installed.
  *
  */
 
 #include <iostream>
 #include <vector>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <limits>
+#include <stdint.h>
 #include "CTikz.hpp"
 #include "CException.hpp"
+#include "CFilter.hpp"
+#include "CTikzBatch.hpp"
+#include "CProcess.hpp"
 
 // 1. example uses C array
 void m_example1_vd(const int f_NumSamples_i);
@@ -27,6 +39,57 @@ void m_example3_vd(const int f_NumSamples_i);
 // and additional settings (legend, nodes)
 void m_example4_vd(const int f_NumSamples_i);
 
+// 5. example saves state of figure into binary file and loads it again
+void m_example5_vd(const int f_NumSamples_i);
+
+// 6. example copies figure, copies are independent and get own IDs
+void m_example6_vd(const int f_NumSamples_i);
+
+// 7. example reduces figure which exceeds TeX cost budget
+void m_example7_vd(const int f_NumSamples_i);
+
+// 8. example writes large data set entry in chunks
+void m_example8_vd(const int f_NumSamples_i);
+
+// 9. example runs program which exceeds its timeout
+void m_example9_vd(const int f_NumSamples_i);
+
+// 10. example creates several figures in parallel
+void m_example10_vd(const int f_NumSamples_i);
+
+// 11. example adds several data set entries with common x values (one shared table)
+void m_example11_vd(const int f_NumSamples_i);
+
+// 12. example adds data with uniform x values (only y values are written)
+void m_example12_vd(const int f_NumSamples_i);
+
+// 13. example adds data with values which are not finite (gaps)
+void m_example13_vd(const int f_NumSamples_i);
+
+// 14. example adds data with timestamps (time axis)
+void m_example14_vd(const int f_NumSamples_i);
+
+// 15. example smoothes data with filter stages
+void m_example15_vd(const int f_NumSamples_i);
+
+// print result of check and count failed checks
+void m_check_vd(bool f_ok_b, const std::string& f_name_s);
+
+// read file into string (empty when file cannot be read)
+std::string m_readFile_s(const std::string& f_filename_s);
+
+// count occurrences of pattern in text
+std::size_t m_count_i(const std::string& f_text_s, const std::string& f_pattern_s);
+
+// get ID of object out of labels of tikz code
+std::string m_getId_s(const std::string& f_tikz_s);
+
+// remove ID of object out of labels of tikz code
+std::string m_stripIds_s(const std::string& f_tikz_s);
+
+// number of failed checks
+static int g_numFailed_i = 0;
+
 
 // ========================================================================
 // main function
@@ -51,15 +114,51 @@ int main(int argc, const char * argv[]) {
     // run fourth example
     m_example4_vd(l_NumSamples_i);
     
+    // run fifth example (save and load state)
+    m_example5_vd(l_NumSamples_i);
+    
+    // run sixth example (copies of figure)
+    m_example6_vd(l_NumSamples_i);
+    
+    // run seventh example (TeX cost budget)
+    m_example7_vd(l_NumSamples_i);
+    
+    // run eighth example (chunks)
+    m_example8_vd(l_NumSamples_i);
+    
+    // run ninth example (timeout of program)
+    m_example9_vd(l_NumSamples_i);
+    
+    // run tenth example (batch of figures)
+    m_example10_vd(l_NumSamples_i);
+    
+    // run eleventh example (common x values)
+    m_example11_vd(l_NumSamples_i);
+    
+    // run twelfth example (uniform x values)
+    m_example12_vd(l_NumSamples_i);
+    
+    // run thirteenth example (gaps)
+    m_example13_vd(l_NumSamples_i);
+    
+    // run fourteenth example (time axis)
+    m_example14_vd(l_NumSamples_i);
+    
+    // run fifteenth example (filters)
+    m_example15_vd(l_NumSamples_i);
+    
   } catch (CException & f_Exception_c) {
     std::cout << "Exception occured: " << f_Exception_c.what() << std::endl;
+    ++g_numFailed_i;
   } catch (std::exception& f_Exception_c) {
     std::cout << "std::exception occured: " << f_Exception_c.what() << std::endl;
+    ++g_numFailed_i;
   } catch (...) {
     std::cout << "Unknown exception occured." << std::endl;
+    ++g_numFailed_i;
   }
   
-  return 0;
+  return (0 == g_numFailed_i) ? 0 : 1;
 }
 
 // ========================================================================
@@ -239,6 +338,426 @@ void m_example4_vd(const int f_NumSamples_i)
 }
 
 
+// ========================================================================
+// 5. example saves state of figure into binary file and loads it again
+// ========================================================================
+void m_example5_vd(const int f_NumSamples_i)
+{
+  std::cout << "run fifth example (save and load state)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x * x);
+    l_exampleY_v.push_back(std::sqrt(x));
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v, "", "", "", "sqrt");
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleX_v, "", "", "", "square");
+  l_tikz_c.setTitle_vd("Fifth example");
+  l_tikz_c.setLabel_vd("x", "y");
+  std::remove("example5.tikz");
+  l_tikz_c.createTikzFile_vd("example5.tikz");
+  
+  // save state, load it into other object and create same tikz file again
+  std::remove("example5.bin");
+  l_tikz_c.saveState_vd("example5.bin");
+  CTikz l_loaded_c;
+  l_loaded_c.loadState_vd("example5.bin");
+  std::remove("example5_loaded.tikz");
+  l_loaded_c.createTikzFile_vd("example5_loaded.tikz");
+  m_check_vd(m_stripIds_s(m_readFile_s("example5.tikz")) == m_stripIds_s(m_readFile_s("example5_loaded.tikz")),
+             "loaded state creates same tikz file");
+  m_check_vd(l_loaded_c.getTitle_s() == "Fifth example", "loaded state has title");
+}
+
+
+// ========================================================================
+// 6. example copies figure, copies are independent and get own IDs
+// ========================================================================
+void m_example6_vd(const int f_NumSamples_i)
+{
+  std::cout << "run sixth example (copies of figure)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x);
+    l_exampleY_v.push_back(x % 7);
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v);
+  l_tikz_c.setTitle_vd("Sixth example");
+  l_tikz_c.setLegend_vd("samples");
+  std::remove("example6.tikz");
+  l_tikz_c.createTikzFile_vd("example6.tikz");
+  
+  // change copy (data is shared until copy is changed), original stays as it is
+  CTikz l_copy_c(l_tikz_c);
+  l_copy_c.setTitle_vd("Copy of sixth example");
+  l_copy_c.addData_vd(l_exampleY_v, l_exampleX_v);
+  CTikz l_assigned_c;
+  l_assigned_c = l_tikz_c;
+  std::remove("example6_copy.tikz");
+  l_copy_c.createTikzFile_vd("example6_copy.tikz");
+  std::remove("example6_assigned.tikz");
+  l_assigned_c.createTikzFile_vd("example6_assigned.tikz");
+  std::remove("example6_again.tikz");
+  l_tikz_c.createTikzFile_vd("example6_again.tikz");
+  
+  const std::string l_original_s = m_readFile_s("example6.tikz");
+  const std::string l_copy_s = m_readFile_s("example6_copy.tikz");
+  const std::string l_assigned_s = m_readFile_s("example6_assigned.tikz");
+  m_check_vd(l_original_s == m_readFile_s("example6_again.tikz"), "original is not changed by copy");
+  m_check_vd(l_tikz_c.getTitle_s() == "Sixth example", "title of original is kept");
+  m_check_vd(m_count_i(l_copy_s, "\\addplot") == 2 * m_count_i(l_original_s, "\\addplot"), "copy has own data set entries");
+  m_check_vd(m_stripIds_s(l_assigned_s) == m_stripIds_s(l_original_s), "assigned copy creates same tikz file");
+  m_check_vd((m_getId_s(l_copy_s) != m_getId_s(l_original_s)) && (m_getId_s(l_assigned_s) != m_getId_s(l_original_s)) &&
+             (m_getId_s(l_copy_s) != m_getId_s(l_assigned_s)), "copies get new IDs");
+}
+
+
+// ========================================================================
+// 7. example reduces figure which exceeds TeX cost budget
+// ========================================================================
+void m_example7_vd(const int f_NumSamples_i)
+{
+  std::cout << "run seventh example (TeX cost budget)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < 1000 * f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x);
+    l_exampleY_v.push_back(std::sin(0.001 * x) + 0.1 * std::sin(0.7 * x));
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v);
+  const double l_cost_d = l_tikz_c.estimateCost_d();
+  
+  // figure exceeding budget is rejected
+  bool l_rejected_b = false;
+  l_tikz_c.setBudget_vd(l_cost_d / 10, e_TIKZ_BudgetReject);
+  try {
+    std::remove("example7.tikz");
+    l_tikz_c.createTikzFile_vd("example7.tikz");
+  } catch (CException&) {
+    l_rejected_b = true;
+  }
+  m_check_vd(l_rejected_b, "figure exceeding budget is rejected");
+  
+  // figure exceeding budget is reduced
+  l_tikz_c.setBudget_vd(l_cost_d / 10, e_TIKZ_BudgetReduce);
+  std::remove("example7.tikz");
+  l_tikz_c.createTikzFile_vd("example7.tikz");
+  const std::string l_tikz_s = m_readFile_s("example7.tikz");
+  m_check_vd(!l_tikz_s.empty() && (m_count_i(l_tikz_s, "\\\\") < l_exampleX_v.size() / 5), "figure exceeding budget is reduced");
+}
+
+
+// ========================================================================
+// 8. example writes large data set entry in chunks
+// ========================================================================
+void m_example8_vd(const int f_NumSamples_i)
+{
+  std::cout << "run eighth example (chunks)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x);
+    l_exampleY_v.push_back(x * x);
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v);
+  l_tikz_c.setChunkSize_vd(f_NumSamples_i / 10);
+  std::remove("example8.tikz");
+  l_tikz_c.createTikzFile_vd("example8.tikz");
+  m_check_vd(m_count_i(m_readFile_s("example8.tikz"), "\\addplot") >= 10, "data set entry is written in chunks");
+}
+
+
+// ========================================================================
+// 9. example runs program which exceeds its timeout
+// ========================================================================
+void m_example9_vd(const int f_NumSamples_i)
+{
+  std::cout << "run ninth example (timeout of program)" << std::endl;
+  
+  std::vector<std::string> l_args_v;
+  l_args_v.push_back("sleep");
+  l_args_v.push_back("10");
+  const std::chrono::steady_clock::time_point l_start_c = std::chrono::steady_clock::now();
+  const gType_PROCESS_Result_st l_result_st = CProcess::run_st(l_args_v, 0.001 * f_NumSamples_i);
+  const double l_duration_d = std::chrono::duration<double>(std::chrono::steady_clock::now() - l_start_c).count();
+  m_check_vd(l_result_st.timeout_b && (-1 == l_result_st.exitCode_i), "program is killed when timeout expires");
+  m_check_vd(l_duration_d < 5, "run returns soon after timeout");
+  
+  l_args_v[1] = "0";
+  m_check_vd(!CProcess::run_st(l_args_v, 10).timeout_b, "program finishing in time is not killed");
+}
+
+
+// ========================================================================
+// 10. example creates several figures in parallel
+// ========================================================================
+void m_example10_vd(const int f_NumSamples_i)
+{
+  std::cout << "run tenth example (batch of figures)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x);
+    l_exampleY_v.push_back(std::cos(0.1 * x));
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v);
+  
+  // each figure is copy with own title, workers create tikz files
+  const int l_numFigures_i = 8;
+  CTikzBatch l_batch_c(4);
+  for (int l_k_i = 0; l_k_i < l_numFigures_i; ++l_k_i) {
+    std::stringstream l_title_ss;
+    l_title_ss << "Tenth example " << l_k_i;
+    l_tikz_c.setTitle_vd(l_title_ss.str());
+    std::stringstream l_filename_ss;
+    l_filename_ss << "example10_" << l_k_i << ".tikz";
+    std::remove(l_filename_ss.str().c_str());
+    l_batch_c.add_vd(l_tikz_c, l_filename_ss.str());
+  }
+  l_batch_c.wait_vd();
+  
+  int l_numCreated_i = 0;
+  for (int l_k_i = 0; l_k_i < l_numFigures_i; ++l_k_i) {
+    std::stringstream l_title_ss;
+    l_title_ss << "title={Tenth example " << l_k_i << "}";
+    std::stringstream l_filename_ss;
+    l_filename_ss << "example10_" << l_k_i << ".tikz";
+    l_numCreated_i += (std::string::npos != m_readFile_s(l_filename_ss.str()).find(l_title_ss.str())) ? 1 : 0;
+  }
+  m_check_vd(l_numFigures_i == l_numCreated_i, "batch creates all figures");
+}
+
+
+// ========================================================================
+// 11. example adds several data set entries with common x values (one shared table)
+// ========================================================================
+void m_example11_vd(const int f_NumSamples_i)
+{
+  std::cout << "run eleventh example (common x values)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<std::vector<double> > l_exampleY_v(3);
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(0.01 * x * x);
+    l_exampleY_v[0].push_back(std::sin(0.1 * x));
+    l_exampleY_v[1].push_back(std::cos(0.1 * x));
+    l_exampleY_v[2].push_back(0.5);
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addDataColumns_vd(l_exampleX_v, l_exampleY_v);
+  std::remove("example11.tikz");
+  l_tikz_c.createTikzFile_vd("example11.tikz");
+  const std::string l_tikz_s = m_readFile_s("example11.tikz");
+  m_check_vd((1 == m_count_i(l_tikz_s, "\\pgfplotstableread")) && (3 == m_count_i(l_tikz_s, "\\addplot")),
+             "data set entries with common x values share one table");
+}
+
+
+// ========================================================================
+// 12. example adds data with uniform x values (only y values are written)
+// ========================================================================
+void m_example12_vd(const int f_NumSamples_i)
+{
+  std::cout << "run twelfth example (uniform x values)" << std::endl;
+  
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleY_v.push_back(x % 10);
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.addDataUniform_vd(-1, 0.5, l_exampleY_v);
+  std::remove("example12.tikz");
+  l_tikz_c.createTikzFile_vd("example12.tikz");
+  m_check_vd(std::string::npos != m_readFile_s("example12.tikz").find("x expr=\\coordindex*0.5-1,"), "uniform x values are written as expression");
+}
+
+
+// ========================================================================
+// 13. example adds data with values which are not finite (gaps)
+// ========================================================================
+void m_example13_vd(const int f_NumSamples_i)
+{
+  std::cout << "run thirteenth example (gaps)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x);
+    l_exampleY_v.push_back((x % 20 < 5) ? std::numeric_limits<double>::quiet_NaN() : x);
+  }
+  l_exampleY_v[f_NumSamples_i / 2] = std::numeric_limits<double>::infinity();
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v);
+  std::remove("example13.tikz");
+  l_tikz_c.createTikzFile_vd("example13.tikz");
+  const std::string l_tikz_s = m_readFile_s("example13.tikz");
+  m_check_vd(std::string::npos != l_tikz_s.find("unbounded coords=jump"), "gaps split line");
+  m_check_vd((std::string::npos == l_tikz_s.find("inf\\\\")) && (std::string::npos != l_tikz_s.find("ymax=99,")), "range leaves out values which are not finite");
+}
+
+
+// ========================================================================
+// 14. example adds data with timestamps (time axis)
+// ========================================================================
+void m_example14_vd(const int f_NumSamples_i)
+{
+  std::cout << "run fourteenth example (time axis)" << std::endl;
+  
+  // one sample per minute in milliseconds, starting at 2026-01-01 00:00:00 UTC
+  const int64_t l_start_i = 1767225600000LL;
+  std::vector<int64_t> l_time_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_time_v.push_back(l_start_i + 60000LL * x);
+    l_exampleY_v.push_back(x % 30);
+  }
+  CTikz l_tikz_c;
+  l_tikz_c.setTimeAxis_vd(l_start_i, e_TIKZ_TimeUnitMilliseconds);
+  l_tikz_c.addDataTime_vd(l_time_v, l_exampleY_v);
+  std::remove("example14.tikz");
+  l_tikz_c.createTikzFile_vd("example14.tikz");
+  const std::string l_tikz_s = m_readFile_s("example14.tikz");
+  m_check_vd(std::string::npos != l_tikz_s.find("xticklabels={{2026-01-01\\\\00:00}"), "first tick of time axis is labeled with date and time");
+  m_check_vd(std::string::npos != l_tikz_s.find("xtick={0,"), "ticks of time axis are relative to epoch");
+  
+  bool l_rejected_b = false;
+  try {
+    l_tikz_c.setTimeAxis_vd(0);
+  } catch (CException&) {
+    l_rejected_b = true;
+  }
+  m_check_vd(l_rejected_b, "epoch cannot be changed while data with timestamps exists");
+}
+
+
+// ========================================================================
+// 15. example smoothes data with filter stages
+// ========================================================================
+void m_example15_vd(const int f_NumSamples_i)
+{
+  std::cout << "run fifteenth example (filters)" << std::endl;
+  
+  std::vector<double> l_exampleX_v;
+  std::vector<double> l_exampleY_v;
+  for (int x=0; x < f_NumSamples_i; ++x) {
+    l_exampleX_v.push_back(x);
+    l_exampleY_v.push_back((x % 2) ? 3 : 1);
+  }
+  const std::vector<double> l_original_v = l_exampleY_v;
+  
+  // moving average of alternating values is their mean (window is shortened at both ends)
+  CFilter l_filter_c(l_exampleY_v);
+  l_filter_c.addMovingAverage_vd(5);
+  std::vector<double> l_filtered_v;
+  l_filter_c.getFiltered_vd(l_filtered_v);
+  bool l_mean_b = (l_filtered_v.size() == l_exampleY_v.size());
+  for (std::size_t l_k_i = 2; l_mean_b && (l_k_i + 2 < l_filtered_v.size()); ++l_k_i) {
+    l_mean_b = (std::fabs(l_filtered_v[l_k_i] - 2) < 0.5);
+  }
+  m_check_vd(l_mean_b, "moving average smoothes data");
+  
+  // filter of data set entry is applied while data is written
+  CTikz l_tikz_c;
+  l_tikz_c.addData_vd(l_exampleX_v, l_exampleY_v);
+  l_tikz_c.addFilter_vd(0, e_TIKZ_FilterMovingAverage, 5);
+  l_tikz_c.addFilter_vd(0, e_TIKZ_FilterSavitzkyGolay, 7, 2);
+  std::remove("example15.tikz");
+  l_tikz_c.createTikzFile_vd("example15.tikz");
+  const std::string l_tikz_s = m_readFile_s("example15.tikz");
+  m_check_vd((std::string::npos == l_tikz_s.find("ymin=1,")) && (std::string::npos == l_tikz_s.find("ymax=3,")), "filtered data is written");
+  m_check_vd(l_exampleY_v == l_original_v, "data of user is not changed by filter");
+  
+  bool l_rejected_b = false;
+  try {
+    l_tikz_c.addFilter_vd(0, e_TIKZ_FilterExponential, 2);
+  } catch (CException&) {
+    l_rejected_b = true;
+  }
+  m_check_vd(l_rejected_b, "invalid parameter of filter is rejected");
+}
+
+
+// ========================================================================
+// print result of check and count failed checks
+// ========================================================================
+void m_check_vd(bool f_ok_b, const std::string& f_name_s)
+{
+  std::cout << "  check " << f_name_s << ": " << (f_ok_b ? "ok" : "FAILED") << std::endl;
+  if (!f_ok_b) {
+    ++g_numFailed_i;
+  }
+}
+
+
+// ========================================================================
+// read file into string (empty when file cannot be read)
+// ========================================================================
+std::string m_readFile_s(const std::string& f_filename_s)
+{
+  std::ifstream l_file_c(f_filename_s.c_str(), std::ios::in | std::ios::binary);
+  std::stringstream l_content_ss;
+  l_content_ss << l_file_c.rdbuf();
+  return l_content_ss.str();
+}
+
+
+// ========================================================================
+// count occurrences of pattern in text
+// ========================================================================
+std::size_t m_count_i(const std::string& f_text_s, const std::string& f_pattern_s)
+{
+  std::size_t l_count_i = 0;
+  for (std::size_t l_pos_i = f_text_s.find(f_pattern_s); std::string::npos != l_pos_i; l_pos_i = f_text_s.find(f_pattern_s, l_pos_i + f_pattern_s.size())) {
+    ++l_count_i;
+  }
+  return l_count_i;
+}
+
+
+// ========================================================================
+// get ID of object out of labels of tikz code (addPlotLabel_<ID>_<index>)
+// ========================================================================
+std::string m_getId_s(const std::string& f_tikz_s)
+{
+  const std::string l_label_s = "addPlotLabel_";
+  const std::size_t l_begin_i = f_tikz_s.find(l_label_s);
+  if (std::string::npos == l_begin_i) {
+    return "";
+  }
+  const std::size_t l_end_i = f_tikz_s.find('_', l_begin_i + l_label_s.size());
+  return f_tikz_s.substr(l_begin_i + l_label_s.size(), l_end_i - l_begin_i - l_label_s.size());
+}
+
+
+// ========================================================================
+// remove ID of object out of labels of tikz code
+// ========================================================================
+std::string m_stripIds_s(const std::string& f_tikz_s)
+{
+  const std::string l_id_s = m_getId_s(f_tikz_s);
+  std::string l_tikz_s = f_tikz_s;
+  if (l_id_s.empty()) {
+    return l_tikz_s;
+  }
+  const std::string l_label_s = "addPlotLabel_" + l_id_s;
+  for (std::size_t l_pos_i = l_tikz_s.find(l_label_s); std::string::npos != l_pos_i; l_pos_i = l_tikz_s.find(l_label_s, l_pos_i)) {
+    l_tikz_s.replace(l_pos_i, l_label_s.size(), "addPlotLabel_");
+  }
+  return l_tikz_s;
+}
+
+
 // ========================================================================
 // naming convention
 // prefix: